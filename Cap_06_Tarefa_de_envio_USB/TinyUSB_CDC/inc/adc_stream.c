@@ -0,0 +1,174 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include "adc_capture.h"
+#include "adc_stream.h"
+
+// A aquisição (adc_capture) entrega cada bloco na interrupção do DMA; com uma só entrada, o
+// ponteiro é o próprio bloco do DMA. A interrupção só anota o bloco numa fila curta, e o laço
+// principal (adc_stream_task) escreve o cabeçalho e passa o bloco direto a tud_cdc_write.
+// O bloco continua intacto até o DMA terminar o bloco seguinte (os dois se revezam), então
+// cada quadro tem um período de bloco para sair (4,1 ms a 500 mil amostras/s, ~1 MB/s, perto do
+// limite da USB Full Speed); se a fila estiver cheia, o bloco é descartado e o salto na sequência
+// mostra a perda ao decodificador
+
+// Blocos anotados pela interrupção e ainda não enviados (um produtor, um consumidor)
+#define adc_stream_queue_length 2
+
+struct adc_stream_block {
+    const uint16_t *samples;
+    uint16_t count;
+    uint8_t input;
+    uint32_t sequence;
+    uint64_t timestamp_us;
+};
+
+static struct adc_stream_block queue[adc_stream_queue_length];
+static volatile uint32_t head = 0; // escrito só pela interrupção
+static volatile uint32_t tail = 0; // escrito só pelo laço principal
+
+static volatile bool active = false;
+static volatile uint32_t delivered = 0; // blocos entregues pela aquisição
+static volatile uint32_t dropped = 0;
+static uint32_t frames = 0, overwritten = 0;
+static uint64_t bytes = 0, started_us = 0, stopped_us = 0;
+
+// CRC-16/CCITT (polinômio 0x1021, início 0xFFFF)
+static uint16_t adc_stream_crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t) data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// Função de bloco da aquisição (interrupção DMA_IRQ_0)
+static void adc_stream_on_block(uint input, const uint16_t *samples, uint count) {
+    uint32_t sequence = delivered;
+    delivered = sequence + 1;
+
+    if (head - tail >= adc_stream_queue_length) {
+        dropped++;
+        return;
+    }
+
+    struct adc_stream_block *block = &queue[head % adc_stream_queue_length];
+    block->samples = samples;
+    block->count = count;
+    block->input = input;
+    block->sequence = sequence;
+    block->timestamp_us = time_us_64();
+    __dmb();
+    head = head + 1;
+}
+
+// Inicia a transmissão das amostras de uma entrada, com o ADC a 'rate' amostras/s; durante uma
+// transmissão, para a atual e recomeça do zero
+void adc_stream_start(uint input, uint32_t rate) {
+    if (active) {
+        adc_stream_stop();
+    }
+
+    head = tail = 0;
+    delivered = dropped = 0;
+    frames = overwritten = 0;
+    bytes = 0;
+    started_us = time_us_64();
+    active = true;
+
+    adc_capture_set_rate(rate);
+    adc_capture_start(input, adc_stream_on_block);
+}
+
+void adc_stream_stop() {
+    if (active) {
+        adc_capture_stop();
+        stopped_us = time_us_64();
+        active = false;
+    }
+}
+
+bool adc_stream_active() {
+    return active;
+}
+
+// Escreve 'length' bytes na CDC, rodando a pilha USB enquanto o buffer de saída estiver cheio.
+// Retorna false se o terminal fechou a porta
+static bool adc_stream_write(const void *data, uint32_t length) {
+    const uint8_t *cursor = data;
+
+    while (length) {
+        uint32_t written = tud_cdc_write(cursor, length);
+        cursor += written;
+        length -= written;
+        if (length) {
+            tud_cdc_write_flush();
+            tud_task();
+            if (!tud_cdc_connected()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Envia os blocos pendentes; chame no laço principal, no lugar de tud_task, durante a transmissão
+void adc_stream_task() {
+    while (tail != head) {
+        __dmb(); // lê a entrada só depois de ver o índice publicado
+        struct adc_stream_block block = queue[tail % adc_stream_queue_length];
+        __dmb();
+        tail = tail + 1;
+
+        struct adc_stream_header header = {
+            .magic = adc_stream_magic,
+            .sequence = block.sequence,
+            .timestamp_us = block.timestamp_us,
+            .period_ns = adc_capture_sample_period_ns(),
+            .count = block.count,
+            .input = block.input,
+            .version = adc_stream_version,
+            .dropped = dropped,
+        };
+        header.crc = adc_stream_crc16((const uint8_t *) &header, offsetof(struct adc_stream_header, crc));
+
+        uint32_t length = block.count * sizeof(uint16_t);
+        if (!adc_stream_write(&header, sizeof(header)) || !adc_stream_write(block.samples, length)) {
+            adc_stream_stop();
+            return;
+        }
+
+        // O DMA volta a este bloco quando o seguinte termina: se isso aconteceu antes de a
+        // última amostra entrar no buffer da USB, o quadro é marcado como inválido. A entrega do
+        // bloco seguinte só é contada na interrupção, depois de o DMA já ter voltado a este: é o
+        // canal do bloco que diz se ele recomeçou; a contagem, lida por último, cobre o caso de
+        // o bloco ter sido reescrito por inteiro desde então
+        uint32_t trailer = block.sequence;
+        if (!adc_capture_block_intact(block.samples) || delivered > block.sequence + 1) {
+            trailer = ~trailer;
+            overwritten++;
+        }
+        if (!adc_stream_write(&trailer, sizeof(trailer))) {
+            adc_stream_stop();
+            return;
+        }
+
+        frames++;
+        bytes += sizeof(header) + length + sizeof(trailer);
+    }
+    tud_cdc_write_flush();
+    tud_task();
+}
+
+void adc_stream_get_stats(struct adc_stream_stats *out) {
+    out->frames = frames;
+    out->dropped = dropped;
+    out->overwritten = overwritten;
+    out->bytes = bytes;
+    out->elapsed_us = (active ? time_us_64() : stopped_us) - started_us;
+}
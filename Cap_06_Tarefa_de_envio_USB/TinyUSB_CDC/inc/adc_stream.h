@@ -0,0 +1,43 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_stream_inc_h
+#define adc_stream_inc_h
+
+// Transmissão binária das amostras do ADC pela USB CDC. Cada bloco que o DMA enche vira um
+// quadro: cabeçalho, as amostras (uint16_t little-endian, direto do bloco do DMA, sem cópia
+// nem formatação) e um terminador. O decodificador fica em tools/adc_stream.py
+#define adc_stream_magic 0x53434441u // "ADCS"
+#define adc_stream_version 1
+
+// Cabeçalho de cada quadro (32 bytes, little-endian)
+struct adc_stream_header {
+    uint32_t magic;
+    uint32_t sequence;     // número do bloco desde o início (um salto = blocos perdidos)
+    uint64_t timestamp_us; // instante (time_us_64) em que o bloco terminou (a última amostra)
+    uint32_t period_ns;    // intervalo entre amostras
+    uint16_t count;        // amostras no quadro
+    uint8_t input;         // entrada do ADC
+    uint8_t version;
+    uint32_t dropped;      // blocos descartados até aqui por falta de vazão na USB
+    uint16_t reserved;
+    uint16_t crc;          // CRC-16/CCITT dos 30 bytes anteriores
+};
+
+// Depois das amostras vem um uint32_t: 'sequence' se o bloco foi enviado inteiro, ou o seu
+// complemento se o DMA começou a reescrevê-lo antes do fim do envio (o quadro deve ser descartado)
+
+struct adc_stream_stats {
+    uint32_t frames;      // quadros enviados
+    uint32_t dropped;     // blocos descartados antes do envio (fila cheia)
+    uint32_t overwritten; // quadros enviados com o bloco já reescrito
+    uint64_t bytes;
+    uint64_t elapsed_us;  // do início até agora, ou até a parada
+};
+
+extern void adc_stream_start(uint input, uint32_t rate);
+extern void adc_stream_stop();
+extern bool adc_stream_active();
+extern void adc_stream_task();
+extern void adc_stream_get_stats(struct adc_stream_stats *out);
+
+#endif
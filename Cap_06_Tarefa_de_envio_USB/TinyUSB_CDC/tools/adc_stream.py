@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+# Decodificador dos quadros binários do comando "stream" (inc/adc_stream.h) e verificação de
+# perdas com a placa ligada.
+#
+#   adc_stream.py check --port /dev/ttyACM0 [--rate 500000] [--seconds 10]
+#       pede o stream, decodifica ao vivo e falha (código 1) se algum quadro se perdeu
+#   adc_stream.py decode captura.bin [-o amostras.txt]
+#       decodifica uma captura gravada da porta; as amostras saem uma por linha, no formato que
+#       host/bench_filter do projeto temp lê
+#   adc_stream.py self-test
+#       codifica quadros sintéticos com texto, perdas e blocos reescritos no meio, e confere
+#       se o decodificador conta tudo (não precisa da placa)
+#
+# Quadro: cabeçalho de 32 bytes com CRC-16/CCITT, 'count' amostras uint16 e um terminador uint32
+# igual à sequência (ou ao seu complemento, se o bloco foi reescrito durante o envio). Texto
+# entre os quadros (printf) é ignorado: o decodificador procura a assinatura e confere o CRC.
+# Usa só a biblioteca padrão do Python 3.
+
+import argparse
+import os
+import random
+import struct
+import sys
+import time
+
+MAGIC = 0x53434441
+HEADER = struct.Struct('<IIQIHBBIHH')
+TRAILER = struct.Struct('<I')
+MAGIC_BYTES = struct.pack('<I', MAGIC)
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+class Frame:
+    def __init__(self, sequence, timestamp_us, period_ns, input, dropped, samples, intact):
+        self.sequence = sequence
+        self.timestamp_us = timestamp_us
+        self.period_ns = period_ns
+        self.input = input
+        self.dropped = dropped
+        self.samples = samples
+        self.intact = intact
+
+
+class Decoder:
+    """Decodificador incremental: feed() recebe bytes em qualquer fatiamento e devolve os quadros
+    completos. Conta quadros perdidos (saltos na sequência), reescritos e bytes ignorados."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.frames = 0
+        self.lost = 0
+        self.overwritten = 0
+        self.skipped = 0
+        self.samples = 0
+        self.last_sequence = None
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        while True:
+            start = self.buffer.find(MAGIC_BYTES)
+            if start < 0:
+                keep = len(MAGIC_BYTES) - 1
+                self.skipped += max(0, len(self.buffer) - keep)
+                del self.buffer[:max(0, len(self.buffer) - keep)]
+                return frames
+            self.skipped += start
+            del self.buffer[:start]
+            if len(self.buffer) < HEADER.size:
+                return frames
+
+            fields = HEADER.unpack_from(self.buffer)
+            _, sequence, timestamp_us, period_ns, count, input, version, dropped, _, crc = fields
+            if crc16(self.buffer[:HEADER.size - 2]) != crc:
+                # Assinatura falsa (dentro das amostras ou do texto): procura a próxima
+                self.skipped += 1
+                del self.buffer[:1]
+                continue
+
+            length = HEADER.size + 2 * count + TRAILER.size
+            if len(self.buffer) < length:
+                return frames
+            samples = struct.unpack_from('<%dH' % count, self.buffer, HEADER.size)
+            (trailer,) = TRAILER.unpack_from(self.buffer, HEADER.size + 2 * count)
+            del self.buffer[:length]
+
+            if self.last_sequence is not None:
+                self.lost += (sequence - self.last_sequence - 1) & 0xFFFFFFFF
+            self.last_sequence = sequence
+
+            intact = trailer == sequence
+            if not intact:
+                self.overwritten += 1
+                continue
+            self.frames += 1
+            self.samples += count
+            frames.append(Frame(sequence, timestamp_us, period_ns, input, dropped, samples, intact))
+
+    def summary(self):
+        return ('%d quadros, %d amostras, %d perdidos, %d reescritos, %d bytes ignorados'
+                % (self.frames, self.samples, self.lost, self.overwritten, self.skipped))
+
+
+# ---------------------------------------------------------------------------------------------
+# Porta serial (CDC) sem dependências: modo bruto pelo termios
+
+def open_port(path):
+    import termios
+    import tty
+
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    attributes = termios.tcgetattr(fd)
+    attributes[6][termios.VMIN] = 0
+    attributes[6][termios.VTIME] = 1  # leituras retornam em até 100 ms
+    termios.tcsetattr(fd, termios.TCSANOW, attributes)
+    termios.tcflush(fd, termios.TCIOFLUSH)
+    return fd
+
+
+def check(args):
+    fd = open_port(args.port)
+    decoder = Decoder()
+    first = last = None
+    bytes_read = 0
+
+    os.write(fd, b'stream %d\n' % args.rate)
+    start = time.monotonic()
+    while time.monotonic() - start < args.seconds:
+        data = os.read(fd, 1 << 16)
+        bytes_read += len(data)
+        for frame in decoder.feed(data):
+            first = first or frame
+            last = frame
+    os.write(fd, b'pare\n')
+    elapsed = time.monotonic() - start
+    os.close(fd)
+
+    print(decoder.summary())
+    print('%.0f kB/s pela USB' % (bytes_read / elapsed / 1024))
+    if first and last and last.timestamp_us > first.timestamp_us:
+        span = (last.timestamp_us - first.timestamp_us) / 1e6
+        received = (decoder.samples - len(first.samples)) / span
+        print('%.0f amostras/s recebidas, %.0f amostras/s no ADC' % (received, 1e9 / last.period_ns))
+    if decoder.frames == 0:
+        print('nenhum quadro recebido')
+        return 1
+    if decoder.lost or decoder.overwritten:
+        print('FALHOU: a USB não acompanhou o ADC a %d amostras/s' % args.rate)
+        return 1
+    print('nenhum quadro perdido')
+    return 0
+
+
+def decode(args):
+    decoder = Decoder()
+    out = open(args.output, 'w') if args.output else None
+    with open(args.capture, 'rb') as capture:
+        while True:
+            data = capture.read(1 << 16)
+            if not data:
+                break
+            for frame in decoder.feed(data):
+                if out:
+                    out.write(''.join('%d\n' % sample for sample in frame.samples))
+    if out:
+        out.close()
+    print(decoder.summary())
+    return 0
+
+
+# ---------------------------------------------------------------------------------------------
+# Autoteste do decodificador
+
+def encode(sequence, samples, dropped=0, overwritten=False):
+    header = HEADER.pack(MAGIC, sequence, 1000 + sequence * 4096, 2000, len(samples), 2, 1, dropped, 0, 0)
+    header = header[:-2] + struct.pack('<H', crc16(header[:-2]))
+    trailer = sequence ^ 0xFFFFFFFF if overwritten else sequence
+    return header + struct.pack('<%dH' % len(samples), *samples) + TRAILER.pack(trailer)
+
+
+def self_test(args):
+    generator = random.Random(1)
+    stream = bytearray(b'stream\n')
+    expected_lost = expected_overwritten = expected_frames = 0
+    sequence = 0
+
+    for _ in range(300):
+        # Amostras que às vezes contêm a assinatura, para exercitar a ressincronização
+        samples = [generator.randrange(4096) for _ in range(generator.choice((1, 64, 2048)))]
+        if generator.random() < 0.1:
+            samples[:2] = [MAGIC & 0xFFFF, MAGIC >> 16]
+        overwritten = generator.random() < 0.05
+        stream += encode(sequence, samples, overwritten=overwritten)
+        if overwritten:
+            expected_overwritten += 1
+        else:
+            expected_frames += 1
+        if generator.random() < 0.1:
+            stream += b'Recebido: texto no meio\n'
+        skip = generator.choice((0, 0, 0, 1, 3))
+        expected_lost += skip
+        sequence += 1 + skip
+
+    decoder = Decoder()
+    position = 0
+    while position < len(stream):
+        size = generator.randrange(1, 5000)
+        decoder.feed(bytes(stream[position:position + size]))
+        position += size
+
+    print(decoder.summary())
+    ok = (decoder.frames, decoder.lost, decoder.overwritten) == (expected_frames, expected_lost, expected_overwritten)
+    print('autoteste %s (esperado: %d quadros, %d perdidos, %d reescritos)'
+          % ('passou' if ok else 'FALHOU', expected_frames, expected_lost, expected_overwritten))
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Quadros binários do ADC pela USB CDC')
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    check_parser = commands.add_parser('check', help='pede o stream à placa e confere se houve perdas')
+    check_parser.add_argument('--port', required=True, help='porta CDC (ex.: /dev/ttyACM0)')
+    check_parser.add_argument('--rate', type=int, default=500000, help='amostras/s do ADC')
+    check_parser.add_argument('--seconds', type=float, default=10)
+    check_parser.set_defaults(run=check)
+
+    decode_parser = commands.add_parser('decode', help='decodifica uma captura gravada')
+    decode_parser.add_argument('capture')
+    decode_parser.add_argument('-o', '--output', help='amostras, uma por linha')
+    decode_parser.set_defaults(run=decode)
+
+    test_parser = commands.add_parser('self-test', help='confere o decodificador com quadros sintéticos')
+    test_parser.set_defaults(run=self_test)
+
+    args = parser.parse_args()
+    return args.run(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+
+// Custo do contexto por painel: API legada (constantes de ssd1306_i2c.h) contra a API de
+// contexto num painel 128x64 (caminho especializado) e num 128x32 (largura e altura em variáveis).
+// No fim, uma leitura do temp_mda: redesenhar a linha inteira contra o campo numérico retido
+
+#define ITERATIONS 200000
+
+static uint8_t legacy[ssd1306_buffer_length];
+static uint8_t buffer_64[ssd1306_framebuffer_size(128, 64)];
+static uint8_t buffer_32[ssd1306_framebuffer_size(128, 32)];
+
+static double now_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, double seconds) {
+    printf("%-34s %8.1f ns/chamada\n", name, seconds * 1e9 / ITERATIONS);
+}
+
+int main() {
+    ssd1306_t display_64, display_32;
+    ssd1306_display_init(&display_64, 128, 64, false, 0x3C, i2c0, buffer_64);
+    ssd1306_display_init(&display_32, 128, 32, false, 0x3C, i2c1, buffer_32);
+    const char *text = "Temp: 25.31 °C";
+    double start;
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_draw_text(legacy, 0, (i & 3) * 7 + 3, text, &ssd1306_font_5x8);
+    report("texto, API legada", now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_display_draw_text(&display_64, 0, (i & 3) * 7 + 3, text, &ssd1306_font_5x8);
+    report("texto, contexto 128x64", now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_display_draw_text(&display_32, 0, (i & 3) * 7 + 3, text, &ssd1306_font_5x8);
+    report("texto, contexto 128x32", now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_fill_rect(legacy, 13, (i & 7) + 1, 100, 22, i & 1);
+    report("retângulo 100x22, API legada", now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_display_fill_rect(&display_64, 13, (i & 7) + 1, 100, 22, i & 1);
+    report("retângulo 100x22, contexto 128x64", now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_display_fill_rect(&display_32, 13, (i & 7) + 1, 100, 22, i & 1);
+    report("retângulo 100x22, contexto 128x32", now_s() - start);
+
+    // Leituras que mudam só o último dígito, como as do sensor de temperatura
+    char line[32];
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        snprintf(line, sizeof(line), "Temp: %6.2f °C", 25.31 + (i & 7) * 0.01);
+        ssd1306_display_draw_text(&display_64, 10, 20, line, &ssd1306_font_5x8);
+    }
+    report("leitura, linha redesenhada", now_s() - start);
+
+    ssd1306_widget_t reading;
+    ssd1306_widget_init_number(&reading, &display_64, 46, 20, &ssd1306_font_5x8, 6, 2);
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_widget_set_number(&reading, 2531 + (i & 7));
+    }
+    report("leitura, widget numérico", now_s() - start);
+
+    // Impede que o compilador descarte o desenho
+    uint32_t checksum = 0;
+    for (int i = 0; i < ssd1306_buffer_length; i++) {
+        checksum += legacy[i] + buffer_64[i + 1];
+    }
+    for (int i = 0; i < 128 * 4; i++) {
+        checksum += buffer_32[i + 1];
+    }
+    printf("checksum %u\n", checksum);
+
+    return 0;
+}
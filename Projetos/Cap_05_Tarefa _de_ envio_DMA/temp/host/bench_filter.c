@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "adc_filter.h"
+
+// Reprodução de gravações do ADC por cada filtro de adc_filter.c, em blocos do tamanho dos
+// entregues pela aquisição por DMA, com a vazão em amostras/s.
+//   ./build_host/bench_filter [gravação ...]
+//   ./build_host/bench_filter --check   (só as respostas conhecidas de cada filtro)
+// Gravações em texto (.txt, .csv: um código por linha, como impresso pela serial) ou binárias
+// (qualquer outra extensão: uint16_t little-endian, como no bloco do DMA). Sem argumentos, usa
+// um sinal sintético: rampa lenta, ruído e picos isolados
+
+#define BLOCK_LENGTH 2048 // adc_capture_block_length
+#define SYNTHETIC_LENGTH (1u << 20)
+#define PASSES 8
+
+static double now_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Lê uma gravação; retorna o número de amostras (0 se falhou) e o vetor em *out
+static size_t load_recording(const char *path, uint16_t **out) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        *out = NULL;
+        return 0;
+    }
+
+    size_t capacity = 1 << 16, length = 0;
+    uint16_t *samples = malloc(capacity * sizeof(uint16_t));
+    const char *extension = strrchr(path, '.');
+    bool text = extension && (strcmp(extension, ".txt") == 0 || strcmp(extension, ".csv") == 0);
+
+    while (true) {
+        if (length == capacity) {
+            capacity *= 2;
+            samples = realloc(samples, capacity * sizeof(uint16_t));
+        }
+        if (text) {
+            char line[64];
+            if (!fgets(line, sizeof(line), file)) {
+                break;
+            }
+            char *end;
+            long value = strtol(line, &end, 10);
+            if (end != line && value >= 0 && value <= UINT16_MAX) {
+                samples[length++] = (uint16_t) value;
+            }
+        }
+        else {
+            uint8_t bytes[2];
+            if (fread(bytes, 1, 2, file) != 2) {
+                break;
+            }
+            samples[length++] = bytes[0] | bytes[1] << 8;
+        }
+    }
+    fclose(file);
+
+    *out = samples;
+    return length;
+}
+
+// Sinal de teste no formato do ADC de 12 bits
+static size_t synthesize(uint16_t **out) {
+    uint16_t *samples = malloc(SYNTHETIC_LENGTH * sizeof(uint16_t));
+    uint32_t seed = 1;
+
+    for (size_t i = 0; i < SYNTHETIC_LENGTH; i++) {
+        seed = seed * 1664525 + 1013904223;
+        int value = 1500 + (int) (i * 1000 / SYNTHETIC_LENGTH) + (int) (seed >> 28) - 8;
+        if ((seed & 0xFFF) == 0) {
+            value += 1500; // pico isolado
+        }
+        samples[i] = value < 0 ? 0 : value > 4095 ? 4095 : value;
+    }
+
+    *out = samples;
+    return SYNTHETIC_LENGTH;
+}
+
+// Passa-baixas de 31 coeficientes (sinc com janela de Hamming, corte em 1/16 da taxa) em Q15,
+// com ganho DC de exatamente 1,0
+static int design_lowpass(int16_t *coeffs, int taps) {
+    double h[adc_filter_fir_max], sum = 0;
+    for (int k = 0; k < taps; k++) {
+        double t = k - (taps - 1) / 2.0;
+        double sinc = t == 0 ? 2 * 0.0625 : sin(2 * M_PI * 0.0625 * t) / (M_PI * t);
+        h[k] = sinc * (0.54 - 0.46 * cos(2 * M_PI * k / (taps - 1)));
+        sum += h[k];
+    }
+    int total = 0;
+    for (int k = 0; k < taps; k++) {
+        coeffs[k] = (int16_t) lround(h[k] / sum * 32768);
+        total += coeffs[k];
+    }
+    coeffs[(taps - 1) / 2] += 32768 - total;
+    return taps;
+}
+
+// Diferença média absoluta entre amostras vizinhas: quanto o filtro alisou o sinal
+static double roughness(const uint16_t *samples, size_t length) {
+    uint64_t total = 0;
+    for (size_t i = 1; i < length; i++) {
+        total += abs((int) samples[i] - (int) samples[i - 1]);
+    }
+    return length > 1 ? (double) total / (length - 1) : 0;
+}
+
+static void report(const char *name, size_t length, double seconds, const uint16_t *out) {
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < length; i++) {
+        checksum = checksum * 31 + out[i];
+    }
+    // Alinha pelo número de caracteres, não de bytes (os nomes têm acentos em UTF-8)
+    int width = 0;
+    for (const char *c = name; *c; c++) {
+        width += (*c & 0xC0) != 0x80;
+    }
+    printf("  %s%*s %8.1f M amostras/s  variação %6.2f  checksum %08x\n", name, 26 - width, "",
+           length * (double) PASSES / seconds / 1e6, roughness(out, length), checksum);
+}
+
+// Uma reprodução completa por filtro, PASSES vezes, bloco a bloco; o estado é refeito a cada
+// passada para que a saída (e o checksum) seja a da gravação uma vez só
+#define REPLAY(name, type, init, process)                                          \
+    do {                                                                           \
+        double start = now_s();                                                    \
+        for (int pass = 0; pass < PASSES; pass++) {                                \
+            type filter;                                                           \
+            init;                                                                  \
+            for (size_t offset = 0; offset < length; offset += BLOCK_LENGTH) {     \
+                size_t n = length - offset < BLOCK_LENGTH ? length - offset : BLOCK_LENGTH; \
+                process(&filter, samples + offset, n, out + offset);               \
+            }                                                                      \
+        }                                                                          \
+        report(name, length, now_s() - start, out);                                \
+    } while (0)
+
+static void replay(const char *name, const uint16_t *samples, size_t length) {
+    uint16_t *out = malloc(length * sizeof(uint16_t));
+    int16_t lowpass[adc_filter_fir_max];
+    int taps = design_lowpass(lowpass, 31);
+
+    printf("%s: %zu amostras, variação %.2f\n", name, length, roughness(samples, length));
+    REPLAY("média móvel de 16", adc_filter_average_t, adc_filter_average_init(&filter, 16), adc_filter_average_process);
+    REPLAY("média móvel de 64", adc_filter_average_t, adc_filter_average_init(&filter, 64), adc_filter_average_process);
+    REPLAY("mediana de 5", adc_filter_median_t, adc_filter_median_init(&filter, 5), adc_filter_median_process);
+    REPLAY("mediana de 31", adc_filter_median_t, adc_filter_median_init(&filter, 31), adc_filter_median_process);
+    REPLAY("IIR 1/16", adc_filter_iir_t, adc_filter_iir_init(&filter, 4), adc_filter_iir_process);
+    REPLAY("FIR passa-baixas 31", adc_filter_fir_t, adc_filter_fir_init(&filter, lowpass, taps), adc_filter_fir_process);
+    free(out);
+}
+
+// Respostas conhecidas de cada filtro, com amostras de 12 e de 16 bits (como as do CIC)
+static int failures = 0;
+
+static void expect(const char *name, uint16_t got, uint16_t expected) {
+    bool ok = got == expected;
+    printf("  %-40s %5u (esperado %5u)  %s\n", name, got, expected, ok ? "ok" : "FALHOU");
+    failures += !ok;
+}
+
+static void check_filters() {
+    static const int16_t half[] = { 16384, 16384 };
+    static const int16_t gain_two[] = { 32767, 32767 };
+    static const int16_t difference[] = { 32767, -32767 };
+    int16_t lowpass[adc_filter_fir_max];
+    int taps = design_lowpass(lowpass, 31);
+    uint16_t out = 0;
+
+    printf("respostas conhecidas:\n");
+
+    adc_filter_average_t average;
+    adc_filter_average_init(&average, 64);
+    for (int i = 0; i < 64; i++) {
+        out = adc_filter_average_push(&average, i < 32 ? 60000 : 2000);
+    }
+    expect("média de 64, 60000 e 2000", out, 31000);
+
+    adc_filter_median_t median;
+    adc_filter_median_init(&median, 5);
+    for (int i = 0; i < 5; i++) {
+        out = adc_filter_median_push(&median, i == 2 ? 0 : 60000);
+    }
+    expect("mediana de 5, pico isolado", out, 60000);
+
+    adc_filter_iir_t iir;
+    adc_filter_iir_init(&iir, 4);
+    adc_filter_iir_push(&iir, 0);
+    expect("IIR 1/16, degrau de 0 a 60000", adc_filter_iir_push(&iir, 60000), 3750);
+    adc_filter_iir_init(&iir, 4);
+    expect("IIR 1/16, constante 65535", adc_filter_iir_push(&iir, 65535), 65535);
+    for (int i = 0; i < 1000; i++) {
+        out = adc_filter_iir_push(&iir, 40000);
+    }
+    expect("IIR 1/16, acomodado em 40000", out, 40000);
+
+    adc_filter_fir_t fir;
+    adc_filter_fir_init(&fir, half, 2);
+    adc_filter_fir_push(&fir, 60000);
+    expect("FIR {0,5; 0,5}, de 60000 a 2000", adc_filter_fir_push(&fir, 2000), 31000);
+    adc_filter_fir_init(&fir, gain_two, 2);
+    expect("FIR {1; 1}, 60000 satura", adc_filter_fir_push(&fir, 60000), UINT16_MAX);
+    adc_filter_fir_init(&fir, difference, 2);
+    adc_filter_fir_push(&fir, 2000);
+    expect("FIR {1; -1}, de 2000 a 60000", adc_filter_fir_push(&fir, 60000), 57998);
+    adc_filter_fir_init(&fir, lowpass, taps);
+    expect("FIR passa-baixas 31, constante 60000", adc_filter_fir_push(&fir, 60000), 60000);
+}
+
+int main(int argc, char **argv) {
+    check_filters();
+    if (failures) {
+        printf("%d verificação(ões) falharam\n", failures);
+        return 1;
+    }
+    if (argc == 2 && strcmp(argv[1], "--check") == 0) {
+        return 0;
+    }
+
+    if (argc < 2) {
+        uint16_t *samples;
+        size_t length = synthesize(&samples);
+        replay("sintético", samples, length);
+        free(samples);
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        uint16_t *samples;
+        size_t length = load_recording(argv[i], &samples);
+        if (length) {
+            replay(argv[i], samples, length);
+        }
+        free(samples);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+
+// Benchmark de renderização de texto: caminho antigo (ssd1306_font.h, maiúsculas, y em página)
+// contra o motor de glyphs novo (ASCII + Latin-1, y arbitrário, fonte fixa ou proporcional)
+
+#define ITERATIONS 200000
+
+static uint8_t ssd[ssd1306_buffer_length];
+
+static double now_s() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, int glyphs, double seconds) {
+    printf("%-34s %10.0f glyphs/s\n", name, glyphs / seconds);
+}
+
+int main() {
+    // 16 caracteres que o caminho antigo sabe desenhar (maiúsculas, dígitos e espaço)
+    char legacy_text[] = "TEMP 2531 GRAUS ";
+    const char *text = "Temp: 25.31 °C";
+    int text_glyphs = 14;
+    double start;
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_draw_string(ssd, 0, (i & 7) * 8, legacy_text);
+    }
+    report("ssd1306_draw_string (antigo)", ITERATIONS * 16, now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_draw_text(ssd, 0, (i & 7) * 8, text, &ssd1306_font_5x8);
+    }
+    report("ssd1306_draw_text 5x8, y em página", ITERATIONS * text_glyphs, now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_draw_text(ssd, 0, (i & 7) * 7 + 3, text, &ssd1306_font_5x8);
+    }
+    report("ssd1306_draw_text 5x8, y livre", ITERATIONS * text_glyphs, now_s() - start);
+
+    start = now_s();
+    for (int i = 0; i < ITERATIONS; i++) {
+        ssd1306_draw_text(ssd, 0, (i & 7) * 7 + 3, text, &ssd1306_font_5x8_prop);
+    }
+    report("ssd1306_draw_text proporcional", ITERATIONS * text_glyphs, now_s() - start);
+
+    // Impede que o compilador descarte o desenho
+    uint32_t checksum = 0;
+    for (int i = 0; i < ssd1306_buffer_length; i++) {
+        checksum += ssd[i];
+    }
+    printf("checksum %u\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+
+// Microbenchmark das primitivas por bytes/palavras contra o caminho pixel a pixel
+// (ssd1306_set_pixel). O resultado é dado em pixels por microssegundo
+
+#define ITERATIONS 20000
+
+static uint8_t ssd[ssd1306_buffer_length];
+
+static double now_us() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static void report(const char *name, double pixels, double per_pixel_us, double fast_us) {
+    printf("%-28s %9.1f px/us (pixel a pixel) %9.1f px/us (spans)  x%.1f\n",
+           name, pixels / per_pixel_us, pixels / fast_us, per_pixel_us / fast_us);
+}
+
+// Retângulo pixel a pixel
+static void rect_per_pixel(int x, int y, int width, int height, bool set) {
+    for (int j = y; j < y + height; j++) {
+        for (int i = x; i < x + width; i++) {
+            ssd1306_set_pixel(ssd, i, j, set);
+        }
+    }
+}
+
+// Inversão pixel a pixel: lê o bit e escreve o oposto
+static void invert_per_pixel(int x, int y, int width, int height) {
+    for (int j = y; j < y + height; j++) {
+        for (int i = x; i < x + width; i++) {
+            bool on = ssd[(j / 8) * ssd1306_width + i] & (1 << (j % 8));
+            ssd1306_set_pixel(ssd, i, j, !on);
+        }
+    }
+}
+
+// Círculo preenchido pixel a pixel
+static int circle_per_pixel(int x_c, int y_c, int radius) {
+    int pixels = 0;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            if (x * x + y * y <= radius * radius + radius) {
+                ssd1306_set_pixel(ssd, x_c + x, y_c + y, true);
+                pixels++;
+            }
+        }
+    }
+    return pixels;
+}
+
+int main() {
+    double start, slow, fast;
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) rect_per_pixel(0, 0, ssd1306_width, ssd1306_height, i & 1);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_fill_rect(ssd, 0, 0, ssd1306_width, ssd1306_height, i & 1);
+    fast = now_us() - start;
+    report("tela inteira", (double) ITERATIONS * ssd1306_width * ssd1306_height, slow, fast);
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) rect_per_pixel(13, 5, 100, 30, i & 1);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_fill_rect(ssd, 13, 5, 100, 30, i & 1);
+    fast = now_us() - start;
+    report("retângulo 100x30 (y=5)", (double) ITERATIONS * 100 * 30, slow, fast);
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS * 10; i++) rect_per_pixel(0, i & 63, ssd1306_width, 1, true);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS * 10; i++) ssd1306_draw_hline(ssd, 0, ssd1306_width - 1, i & 63, ssd1306_mode_set);
+    fast = now_us() - start;
+    report("linha horizontal 128", (double) ITERATIONS * 10 * ssd1306_width, slow, fast);
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS * 10; i++) rect_per_pixel(i & 127, 0, 1, ssd1306_height, true);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS * 10; i++) ssd1306_draw_vline(ssd, i & 127, 0, ssd1306_height - 1, ssd1306_mode_set);
+    fast = now_us() - start;
+    report("linha vertical 64", (double) ITERATIONS * 10 * ssd1306_height, slow, fast);
+
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) invert_per_pixel(10, 3, 90, 20);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_invert_region(ssd, 10, 3, 90, 20);
+    fast = now_us() - start;
+    report("inversão 90x20 (y=3)", (double) ITERATIONS * 90 * 20, slow, fast);
+
+    int circle_pixels = 0;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) circle_pixels = circle_per_pixel(64, 32, 25);
+    slow = now_us() - start;
+    start = now_us();
+    for (int i = 0; i < ITERATIONS; i++) ssd1306_fill_circle(ssd, 64, 32, 25, ssd1306_mode_set);
+    fast = now_us() - start;
+    report("círculo preenchido r=25", (double) ITERATIONS * circle_pixels, slow, fast);
+
+    // Impede que o compilador descarte o desenho
+    uint32_t checksum = 0;
+    for (int i = 0; i < ssd1306_buffer_length; i++) {
+        checksum += ssd[i];
+    }
+    printf("checksum %u\n", checksum);
+
+    return 0;
+}
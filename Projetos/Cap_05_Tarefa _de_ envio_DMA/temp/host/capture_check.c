@@ -0,0 +1,311 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "adc_capture.h"
+
+// Verificação da aquisição (adc_capture.c) sobre um ADC e um DMA simulados: o ADC converte em
+// rodízio e cada amostra leva a entrada (bits 13-15) e um contador dessa entrada (bits 0-12);
+// os canais de DMA copiam para os blocos, se encadeiam e marcam a interrupção de fim de bloco.
+// Para cada conjunto de entradas, confere que toda amostra entregue a uma entrada veio dela e
+// em sequência, também depois de uma interrupção atrasada (com 3 ou 5 entradas, 2048 amostras
+// não são um múltiplo do rodízio) e que os blocos perdidos são contados pelo intervalo. Confere
+// também que um bloco entregue é visto como reescrito assim que o DMA volta a ele e que iniciar
+// de novo sem parar não prende mais canais nem registra o tratador duas vezes
+// Uso: capture_check
+
+static int failures = 0;
+
+// Relógio simulado: avança um período de conversão a cada amostra
+static uint64_t now_ns = 0;
+
+uint64_t time_us_64(void) {
+    return now_ns / 1000;
+}
+
+// ADC simulado
+adc_hw_t adc_hw_instance = { .cs = ADC_CS_READY_BITS };
+static uint adc_input = 0, adc_round_robin = 0;
+static bool adc_running = false;
+static uint16_t adc_counter[adc_capture_inputs];
+
+void adc_select_input(uint input) {
+    adc_input = input;
+}
+
+void adc_set_round_robin(uint input_mask) {
+    adc_round_robin = input_mask;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+}
+
+void adc_fifo_drain(void) {
+}
+
+void adc_run(bool run) {
+    adc_running = run;
+}
+
+// DMA simulado: só o que a aquisição usa (escrita de 16 bits a partir do FIFO do ADC)
+#define dma_channels 12
+
+static struct {
+    bool claimed, busy, irq_enabled, irq_pending;
+    dma_channel_config config;
+    uint16_t *write;
+    uint count, done;
+} dma[dma_channels];
+
+int dma_claim_unused_channel(bool required) {
+    for (int i = 0; i < dma_channels; i++) {
+        if (!dma[i].claimed) {
+            memset(&dma[i], 0, sizeof(dma[i]));
+            dma[i].claimed = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    dma[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config config = { .size = DMA_SIZE_32, .read_increment = true, .chain_to = (uint8_t) channel };
+    return config;
+}
+
+void dma_channel_start(uint channel) {
+    dma[channel].busy = true;
+    dma[channel].done = 0;
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger) {
+    dma[channel].config = *config;
+    if (trigger) {
+        dma_channel_start(channel);
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    dma[channel].write = (uint16_t *) write_addr;
+    dma[channel].count = transfer_count;
+    dma_channel_set_config(channel, config, trigger);
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+    dma[channel].irq_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(uint channel) {
+    return dma[channel].irq_enabled && dma[channel].irq_pending;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+    dma[channel].irq_pending = false;
+}
+
+void dma_channel_abort(uint channel) {
+    dma[channel].busy = false;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return dma[channel].busy;
+}
+
+static int claimed_channels() {
+    int claimed = 0;
+    for (int i = 0; i < dma_channels; i++) {
+        claimed += dma[i].claimed;
+    }
+    return claimed;
+}
+
+// Interrupção simulada: o tratador registrado é chamado quando o teste quiser
+static irq_handler_t dma_irq_handler = NULL;
+static int dma_irq_handlers = 0; // registros menos remoções
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    dma_irq_handler = handler;
+    dma_irq_handlers++;
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    dma_irq_handler = NULL;
+    dma_irq_handlers--;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+}
+
+// Converte 'count' amostras: cada uma vai para o canal ativo, que ao fim do bloco marca a
+// interrupção e dispara o canal encadeado
+static void simulate(uint count) {
+    for (uint n = 0; n < count && adc_running; n++) {
+        uint input = adc_input;
+        uint16_t sample = (uint16_t) (input << 13 | (adc_counter[input]++ & 0x1FFF));
+        now_ns += 2000; // 96 ciclos de 48 MHz
+
+        // Próxima entrada do rodízio, em ordem crescente
+        if (adc_round_robin) {
+            do {
+                adc_input = (adc_input + 1) % adc_capture_inputs;
+            } while (!(adc_round_robin & (1u << adc_input)));
+        }
+
+        for (int i = 0; i < dma_channels; i++) {
+            if (!dma[i].busy || dma[i].config.dreq != DREQ_ADC) {
+                continue;
+            }
+            dma[i].write[dma[i].done++] = sample;
+            if (dma[i].done == dma[i].count) {
+                dma[i].busy = false;
+                dma[i].irq_pending = true;
+                if (dma[i].config.chain_to != i) {
+                    dma_channel_start(dma[i].config.chain_to);
+                }
+            }
+            break;
+        }
+    }
+}
+
+// Converte 'count' amostras e atende a interrupção no fim
+static void run(uint count) {
+    simulate(count);
+    if (dma_irq_handler) {
+        dma_irq_handler();
+    }
+}
+
+// Amostras recebidas por entrada: a próxima esperada e os erros
+static int expected[adc_capture_inputs];
+static uint32_t received[adc_capture_inputs];
+static uint32_t wrong_input, out_of_order;
+
+static void on_block(uint input, const uint16_t *samples, uint count) {
+    for (uint i = 0; i < count; i++) {
+        uint from = samples[i] >> 13;
+        int counter = samples[i] & 0x1FFF;
+        if (from != input) {
+            wrong_input++;
+            continue;
+        }
+        if (expected[input] >= 0 && counter != expected[input]) {
+            out_of_order++;
+        }
+        expected[input] = (counter + 1) & 0x1FFF;
+    }
+    received[input] += count;
+}
+
+// Depois de uma perda, a sequência de cada entrada recomeça de onde o ADC estiver
+static void resync() {
+    for (int input = 0; input < adc_capture_inputs; input++) {
+        expected[input] = -1;
+    }
+}
+
+static void check_inputs(uint input_mask) {
+    uint inputs = 0;
+    for (int input = 0; input < adc_capture_inputs; input++) {
+        inputs += (input_mask >> input) & 1;
+    }
+
+    memset(adc_counter, 0, sizeof(adc_counter));
+    memset(received, 0, sizeof(received));
+    wrong_input = out_of_order = 0;
+    resync();
+
+    adc_capture_start_round_robin(input_mask, on_block);
+
+    // Blocos atendidos a tempo, um deles com a interrupção um pouco atrasada
+    for (int block = 0; block < 7; block++) {
+        run(adc_capture_block_length + (block == 3 ? 100 : 0));
+        if (block == 3) {
+            run(adc_capture_block_length - 100);
+        }
+    }
+
+    // Interrupção atrasada por três blocos e meio: descarta tudo e recomeça do início do rodízio
+    struct adc_capture_stats before;
+    adc_capture_get_stats(&before);
+    simulate(3 * adc_capture_block_length + adc_capture_block_length / 2);
+    resync();
+    run(0);
+    for (int block = 0; block < 7; block++) {
+        run(adc_capture_block_length);
+    }
+
+    struct adc_capture_stats stats;
+    adc_capture_get_stats(&stats);
+    adc_capture_stop();
+
+    uint32_t total = 0;
+    for (int input = 0; input < adc_capture_inputs; input++) {
+        total += received[input];
+    }
+    bool ok = wrong_input == 0 && out_of_order == 0 && stats.overruns == 1 && stats.lost == 3 &&
+              stats.blocks == before.blocks + 7 && stats.blocks == 15 && total == stats.blocks * adc_capture_block_length;
+    printf("%u entradas (0x%02X)  %u blocos, %u atrasos, %u perdidos, %u amostras fora da entrada, %u fora de ordem  %s\n",
+           inputs, input_mask, stats.blocks, stats.overruns, stats.lost, wrong_input, out_of_order, ok ? "ok" : "FALHOU");
+    failures += !ok;
+}
+
+// Bloco mais recente entregue com uma só entrada (o próprio bloco do DMA)
+static const uint16_t *last_block = NULL;
+
+static void on_single_block(uint input, const uint16_t *samples, uint count) {
+    last_block = samples;
+}
+
+static void check_block_reuse() {
+    adc_capture_start(2, on_single_block);
+    adc_capture_start(2, on_single_block); // segundo início, sem parar
+    bool single = claimed_channels() == 2 && dma_irq_handlers == 1;
+
+    // Logo depois da entrega o DMA escreve no outro bloco; quando ele termina, o canal deste
+    // volta a ele antes de a interrupção contar a entrega do outro
+    run(adc_capture_block_length);
+    const uint16_t *block = last_block;
+    bool after_delivery = adc_capture_block_intact(block);
+    simulate(adc_capture_block_length - 1);
+    bool before_chain = adc_capture_block_intact(block);
+    simulate(1);
+    bool after_chain = adc_capture_block_intact(block);
+    simulate(adc_capture_block_length);
+    bool rewritten = adc_capture_block_intact(block); // reescrito inteiro, interrupção pendente
+    run(0);
+
+    adc_capture_stop();
+    bool released = claimed_channels() == 0 && dma_irq_handlers == 0;
+
+    bool ok = single && after_delivery && before_chain && !after_chain && !rewritten && released;
+    printf("reinício sem parar: %s  bloco entregue: intacto %s, com o outro a 1 amostra do fim %s, "
+           "com o DMA de volta %s, reescrito %s  %s\n",
+           single ? "2 canais, 1 tratador" : "canais ou tratador duplicados",
+           after_delivery ? "sim" : "não", before_chain ? "sim" : "não", after_chain ? "sim" : "não",
+           rewritten ? "sim" : "não", ok ? "ok" : "FALHOU");
+    failures += !ok;
+}
+
+int main() {
+    static const uint input_masks[] = { 0x04, 0x03, 0x13, 0x17, 0x1F };
+
+    for (int i = 0; i < count_of(input_masks); i++) {
+        check_inputs(input_masks[i]);
+    }
+    check_block_reuse();
+
+    if (failures) {
+        printf("%d verificação(ões) falharam\n", failures);
+        return 1;
+    }
+    printf("todas as verificações passaram\n");
+    return 0;
+}
@@ -0,0 +1,521 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "host_assets.h"
+
+// Verificação do driver no emulador: cada cena desenha, envia ao display e confere
+//   - se a GDDRAM decodificada é igual ao framebuffer do driver;
+//   - a imagem do painel contra o PBM de referência em golden/;
+//   - bytes e transações do quadro contra um orçamento.
+// Uso: emu_check <pasta golden> [--update]   (--update regrava as imagens de referência)
+
+static const char *golden_dir;
+static bool update = false;
+static int failures = 0;
+
+// Confere o último quadro do dispositivo contra o orçamento e a imagem de referência
+static void check_frame(const char *scene, ssd1306_emu_device_t *device, const uint8_t *pixels,
+                        int width, int pages, uint32_t max_transactions, uint32_t max_bytes) {
+    ssd1306_emu_traffic_t frame = ssd1306_emu_end_frame(device);
+    bool ok = true;
+
+    int ram = pixels ? ssd1306_emu_compare_ram(device, pixels, width, pages) : 0;
+    if (ram != 0) {
+        ok = false;
+    }
+    if (frame.transactions > max_transactions || frame.bytes > max_bytes || device->errors) {
+        ok = false;
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, scene);
+    int image;
+    if (update) {
+        image = ssd1306_emu_write_pbm(device, path) ? 0 : -1;
+    }
+    else {
+        image = ssd1306_emu_compare_pbm(device, path);
+    }
+    if (image != 0) {
+        ok = false;
+    }
+
+    printf("%-14s %4u/%-4u transações %6u/%-6u bytes  ram %s  imagem %s  %s\n",
+           scene, frame.transactions, max_transactions, frame.bytes, max_bytes,
+           ram ? "DIFERENTE" : "ok",
+           image < 0 ? "AUSENTE" : image > 0 ? "DIFERENTE" : "ok",
+           ok ? "ok" : "FALHOU");
+    if (image > 0) {
+        printf("%14s %d pixels diferentes de %s\n", "", image, path);
+    }
+    if (!ok) {
+        failures++;
+    }
+}
+
+// Tela de temperatura do temp_mda: primeiro quadro inteiro, depois só os dígitos que mudam
+static void scene_temperature() {
+    uint8_t *ssd = ssd1306_framebuffer.data;
+    ssd1306_emu_device_t *device;
+
+    ssd1306_init();
+    device = ssd1306_emu_device(i2c1, ssd1306_i2c_address);
+    check_frame("init", device, NULL, 0, 0, 1, 28);
+
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_set_dirty_tracking(true);
+    ssd1306_draw_text(ssd, 10, 20, "Temp:  25.31 °C", &ssd1306_font_5x8);
+    render_dirty_on_display(ssd);
+    check_frame("temp_full", device, ssd, ssd1306_width, ssd1306_n_pages, 2, 1034);
+
+    ssd1306_draw_text(ssd, 10, 20, "Temp:  25.38 °C", &ssd1306_font_5x8);
+    render_dirty_on_display(ssd);
+    check_frame("temp_update", device, ssd, ssd1306_width, ssd1306_n_pages, 4, 30);
+
+    ssd1306_set_dirty_tracking(false);
+}
+
+// Primitivas gráficas, com um único envio da tela
+static void scene_graphics() {
+    uint8_t *ssd = ssd1306_framebuffer.data;
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c1, ssd1306_i2c_address);
+    struct render_area frame = { .start_column = 0, .end_column = ssd1306_width - 1, .start_page = 0, .end_page = ssd1306_n_pages - 1 };
+    calculate_render_area_buffer_length(&frame);
+
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_draw_rect(ssd, 0, 0, ssd1306_width, ssd1306_height, ssd1306_mode_set);
+    ssd1306_fill_rect(ssd, 6, 5, 40, 13, ssd1306_mode_set);
+    ssd1306_draw_circle(ssd, 90, 30, 20, ssd1306_mode_set);
+    ssd1306_fill_circle(ssd, 90, 30, 9, ssd1306_mode_set);
+    ssd1306_draw_line(ssd, 4, 60, 60, 22, true);
+    ssd1306_draw_text(ssd, 8, 44, "Olá, ação!", &ssd1306_font_5x8_prop);
+    ssd1306_invert_region(ssd, 4, 42, 60, 11);
+    render_on_display(ssd, &frame);
+    check_frame("graphics", device, ssd, ssd1306_width, ssd1306_n_pages, 2, 1034);
+}
+
+// Bitmap compactado (RLE) desenhado fora do alinhamento de páginas
+static void scene_bitmap() {
+    // Losango 16x16: página 0 e página 1
+    static const uint8_t diamond_rle[] = {
+        0x0F, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80,
+        0x0F, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01,
+    };
+    static const ssd1306_bitmap_t diamond = { 16, 16, true, diamond_rle };
+    uint8_t *ssd = ssd1306_framebuffer.data;
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c1, ssd1306_i2c_address);
+
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_set_dirty_tracking(true);
+    render_dirty_on_display(ssd);
+    ssd1306_emu_end_frame(device);
+
+    for (int i = 0; i < 5; i++) {
+        ssd1306_draw_image(ssd, 3 + i * 25, 5 + i * 7, &diamond);
+    }
+    render_dirty_on_display(ssd);
+    check_frame("bitmap", device, ssd, ssd1306_width, ssd1306_n_pages, 14, 330);
+
+    ssd1306_set_dirty_tracking(false);
+}
+
+// Dois painéis ao mesmo tempo: 128x32 no i2c0 e 128x64 no i2c1 (endereço 0x3D)
+static void scene_dual() {
+    static uint8_t buffer_32[ssd1306_framebuffer_size(128, 32)];
+    static uint8_t buffer_64[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t small, large;
+
+    ssd1306_display_init(&small, 128, 32, false, 0x3C, i2c0, buffer_32);
+    ssd1306_display_init(&large, 128, 64, false, 0x3D, i2c1, buffer_64);
+    ssd1306_display_set_dirty_tracking(&small, true);
+    ssd1306_display_set_dirty_tracking(&large, true);
+
+    ssd1306_display_draw_text(&small, 2, 2, "Painel 128x32", &ssd1306_font_5x8);
+    ssd1306_display_draw_rect(&small, 0, 0, 128, 32, ssd1306_mode_set);
+    ssd1306_display_draw_text(&large, 2, 27, "Painel 128x64", &ssd1306_font_5x8);
+    ssd1306_display_fill_circle(&large, 110, 50, 10, ssd1306_mode_set);
+    ssd1306_display_flush_dirty(&small);
+    ssd1306_display_flush_dirty(&large);
+
+    ssd1306_emu_device_t *device_32 = ssd1306_emu_device(i2c0, 0x3C);
+    ssd1306_emu_device_t *device_64 = ssd1306_emu_device(i2c1, 0x3D);
+    check_frame("dual_128x32", device_32, buffer_32 + 1, 128, 4, 3, 550);
+    check_frame("dual_128x64", device_64, buffer_64 + 1, 128, 8, 3, 1062);
+}
+
+// Scrolling horizontal das páginas 0-3 do painel padrão, oito passos para a direita
+static void scene_scroll() {
+    uint8_t *ssd = ssd1306_framebuffer.data;
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c1, ssd1306_i2c_address);
+    struct render_area frame = { .start_column = 0, .end_column = ssd1306_width - 1, .start_page = 0, .end_page = ssd1306_n_pages - 1 };
+    calculate_render_area_buffer_length(&frame);
+
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_draw_text(ssd, 0, 8, "rolando >>>", &ssd1306_font_5x8);
+    ssd1306_draw_text(ssd, 0, 40, "parado", &ssd1306_font_5x8);
+    render_on_display(ssd, &frame);
+    ssd1306_emu_end_frame(device);
+
+    ssd1306_scroll(true);
+    ssd1306_emu_scroll_step(device, 8);
+    check_frame("scroll", device, NULL, 0, 0, 1, 10);
+    ssd1306_scroll(false);
+}
+
+// Console rolante: cada linha nova de log custa uma página e, com a tela cheia, o comando de
+// linha inicial. Painéis de 64 e de 32 linhas, este com quebra automática de linha
+static void scene_console() {
+    static uint8_t buffer_32[ssd1306_framebuffer_size(128, 32)];
+    static uint8_t buffer_64[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t small, large;
+    ssd1306_console_t console_small, console_large;
+
+    ssd1306_display_init(&large, 128, 64, false, 0x3D, i2c1, buffer_64);
+    ssd1306_display_init(&small, 128, 32, false, 0x3C, i2c0, buffer_32);
+    ssd1306_emu_device_t *device_64 = ssd1306_emu_device(i2c1, 0x3D);
+    ssd1306_emu_device_t *device_32 = ssd1306_emu_device(i2c0, 0x3C);
+
+    ssd1306_console_init(&console_large, &large, &ssd1306_font_5x8);
+    ssd1306_console_init(&console_small, &small, &ssd1306_font_5x8_prop);
+    ssd1306_emu_end_frame(device_64);
+    ssd1306_emu_end_frame(device_32);
+
+    for (int i = 0; i < 19; i++) {
+        ssd1306_console_printf(&console_large, "[%03d] leitura %d °C\n", i, 20 + i % 7);
+    }
+    ssd1306_emu_end_frame(device_64);
+    ssd1306_console_printf(&console_large, "[%03d] leitura %d °C\n", 19, 25);
+    check_frame("console_line", device_64, NULL, 0, 0, 3, 141);
+
+    ssd1306_console_write(&console_small, "Linha longa que não cabe numa única linha do painel de 32\nfim");
+    check_frame("console_32", device_32, NULL, 0, 0, 8, 552);
+}
+
+// Letreiro: a página 7 rola sozinha, sem tráfego depois do comando de configuração
+static void scene_ticker() {
+    static uint8_t buffer[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t display;
+
+    ssd1306_display_init(&display, 128, 64, false, 0x3C, i2c0, buffer);
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c0, 0x3C);
+    ssd1306_display_set_dirty_tracking(&display, true);
+    ssd1306_display_draw_text(&display, 0, 56, "*** letreiro sem tráfego ***", &ssd1306_font_5x8_prop);
+    ssd1306_display_flush_dirty(&display);
+    ssd1306_emu_end_frame(device);
+
+    ssd1306_display_scroll_horizontal(&display, true, 7, 7, ssd1306_scroll_2_frames);
+    ssd1306_emu_scroll_step(device, 20);
+    check_frame("ticker", device, NULL, 0, 0, 1, 11);
+
+    ssd1306_display_scroll_stop(&display);
+}
+
+// Widgets retidos: a tela do temp_mda montada uma vez; depois, uma leitura que muda um dígito
+// envia só a célula desse glyph, e uma que muda tudo (valor menor, barra e ícone) só as partes novas
+static void scene_widget() {
+    static const uint8_t sun_pixels[] = { 0x91, 0x42, 0x18, 0x3D, 0xBC, 0x18, 0x42, 0x89 };
+    static const uint8_t moon_pixels[] = { 0x3C, 0x7E, 0xFF, 0xE7, 0xC3, 0x81, 0x00, 0x00 };
+    static const ssd1306_bitmap_t sun = { 8, 8, false, sun_pixels };
+    static const ssd1306_bitmap_t moon = { 8, 8, false, moon_pixels };
+    static uint8_t buffer[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t display;
+    ssd1306_widget_t caption, reading, unit, gauge, icon;
+
+    ssd1306_display_init(&display, 128, 64, false, 0x3A, i2c0, buffer);
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c0, 0x3A);
+    ssd1306_display_set_dirty_tracking(&display, true);
+    ssd1306_display_flush_dirty(&display);
+    ssd1306_emu_end_frame(device);
+
+    ssd1306_widget_init_label(&caption, &display, 10, 20, &ssd1306_font_5x8);
+    ssd1306_widget_init_number(&reading, &display, 46, 20, &ssd1306_font_5x8, 6, 2);
+    ssd1306_widget_init_label(&unit, &display, 88, 20, &ssd1306_font_5x8);
+    ssd1306_widget_init_bar(&gauge, &display, 10, 32, 108, 10, 0, 5000);
+    ssd1306_widget_init_icon(&icon, &display, 110, 4);
+    ssd1306_widget_set_text(&caption, "Temp:");
+    ssd1306_widget_set_text(&unit, " °C");
+    ssd1306_widget_set_number(&reading, 2531);
+    ssd1306_widget_set_bar(&gauge, 2531);
+    ssd1306_widget_set_icon(&icon, &sun);
+    ssd1306_display_flush_dirty(&display);
+    check_frame("widget_full", device, buffer + 1, 128, 8, 12, 482);
+
+    // Cada atualização retorna se desenhou algo: o mesmo valor não desenha nada, e 25.31 -> 25.38
+    // muda só o campo (a barra continua na mesma coluna e o ícone é o mesmo)
+    bool same = !ssd1306_widget_set_text(&caption, "Temp:") && !ssd1306_widget_set_number(&reading, 2531) &&
+                !ssd1306_widget_set_bar(&gauge, 2531) && !ssd1306_widget_set_icon(&icon, &sun);
+    bool digit = ssd1306_widget_set_number(&reading, 2538);
+    bool digit_rest = ssd1306_widget_set_bar(&gauge, 2538);
+    digit_rest = ssd1306_widget_set_icon(&icon, &sun) || digit_rest;
+    ssd1306_display_flush_dirty(&display);
+    check_frame("widget_digit", device, buffer + 1, 128, 8, 4, 30);
+
+    bool change = ssd1306_widget_set_number(&reading, -987);
+    change = ssd1306_widget_set_bar(&gauge, -987) && change;
+    change = ssd1306_widget_set_icon(&icon, &moon) && change;
+    ssd1306_display_flush_dirty(&display);
+    check_frame("widget_change", device, buffer + 1, 128, 8, 10, 176);
+
+    bool ok = same && digit && !digit_rest && change;
+    printf("%-14s iguais %s, um dígito %s/%s, tudo %s  %s\n", "widget_return", same ? "não" : "SIM",
+           digit ? "sim" : "NÃO", digit_rest ? "SIM" : "não", change ? "sim" : "NÃO", ok ? "ok" : "FALHOU");
+    failures += !ok;
+
+    // O campo mais largo: o máximo de casas com o menor int32 (só no framebuffer, sem flush)
+    ssd1306_widget_t widest;
+    ssd1306_widget_init_number(&widest, &display, 0, 48, &ssd1306_font_5x8, 12, ssd1306_widget_max_decimals);
+    ssd1306_widget_set_number(&widest, INT32_MIN);
+    ok = widest.text.length == 12 && memcmp(widest.text.codes, "-2.147483648", 12) == 0;
+    printf("%-14s %.*s  %s\n", "widget_widest", widest.text.length, (const char *) widest.text.codes, ok ? "ok" : "FALHOU");
+    failures += !ok;
+}
+
+// Gráfico rolante: 600 amostras (senoide lenta + ruído, 3 amostras por coluna com envoltória de
+// mínimo e máximo) e um degrau que força a escala automática a se ajustar. Cada quadro envia só
+// a janela do gráfico; o pior quadro a 400 kHz precisa caber em 1/30 s
+static void scene_chart() {
+    static uint8_t buffer[ssd1306_framebuffer_size(128, 64)];
+    static ssd1306_chart_t chart;
+    ssd1306_t display;
+    ssd1306_widget_t range;
+
+    ssd1306_display_init(&display, 128, 64, false, 0x39, i2c0, buffer);
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c0, 0x39);
+    ssd1306_display_set_dirty_tracking(&display, true);
+    ssd1306_display_flush_dirty(&display);
+    ssd1306_widget_init_label(&range, &display, 0, 4, &ssd1306_font_5x8);
+    ssd1306_chart_init(&chart, &display, 0, 3, 128, 5, 3);
+    ssd1306_display_flush_dirty(&display);
+    ssd1306_emu_end_frame(device);
+
+    uint64_t worst_ns = 0;
+    uint32_t noise = 1;
+    for (int i = 0; i < 600; i++) {
+        noise = noise * 1103515245u + 12345u;
+        int32_t value = 2500 + (int32_t) (300 * sin(i * 0.02)) + (int32_t) ((noise >> 16) % 60) + (i >= 450 ? 400 : 0);
+        if (ssd1306_chart_push(&chart, value)) {
+            ssd1306_display_flush_dirty(&display);
+            ssd1306_emu_traffic_t frame = ssd1306_emu_end_frame(device);
+            if (frame.bus_ns > worst_ns) {
+                worst_ns = frame.bus_ns;
+            }
+        }
+    }
+
+    bool ok = worst_ns * 30 <= 1000000000ull;
+    printf("%-14s %u colunas roladas, %u redesenhos, pior quadro %.2f ms a %u kHz (%.0f quadros/s)  %s\n", "chart",
+           chart.columns_drawn, chart.rescales, worst_ns / 1e6, ssd1306_emu_baudrate(i2c0) / 1000, 1e9 / worst_ns, ok ? "ok" : "FALHOU");
+    failures += !ok;
+
+    int32_t low, high;
+    char text[48]; // dois "%ld" de até 20 caracteres cada
+    ssd1306_chart_get_range(&chart, &low, &high);
+    snprintf(text, sizeof(text), "%ld..%ld", (long) low, (long) high);
+    ssd1306_widget_set_text(&range, text);
+    ssd1306_chart_push(&chart, 2900);
+    ssd1306_chart_push(&chart, 2950);
+    ssd1306_chart_push(&chart, 2910);
+    ssd1306_display_flush_dirty(&display);
+    check_frame("chart", device, buffer + 1, 128, 8, 6, 788);
+}
+
+// Assets convertidos no build por tools/ssd1306_assets.py: os ícones (PBM e PNG) e a fonte BDF
+// do temp_mda, e duas imagens de referência convertidas de volta (PBM P4 + RLE), que precisam
+// reproduzir no painel, pixel a pixel, as imagens de onde vieram
+static void scene_assets() {
+    static const struct { const char *scene; const ssd1306_bitmap_t *image; } round_trips[] = {
+        { "bitmap", &asset_bitmap },
+        { "graphics", &asset_graphics },
+    };
+    static uint8_t buffer[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t display;
+
+    ssd1306_display_init(&display, 128, 64, false, 0x38, i2c0, buffer);
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c0, 0x38);
+    ssd1306_display_set_dirty_tracking(&display, true);
+
+    for (int i = 0; i < count_of(round_trips); i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, round_trips[i].scene);
+
+        ssd1306_display_draw_image(&display, 0, 0, round_trips[i].image);
+        ssd1306_display_flush_dirty(&display);
+        ssd1306_emu_end_frame(device);
+
+        int image = ssd1306_emu_compare_pbm(device, path);
+        printf("%-14s %s.pbm -> asset %s -> painel  imagem %s  %s\n", "assets_pbm", round_trips[i].scene,
+               round_trips[i].image->rle ? "RLE" : "sem compactação",
+               image < 0 ? "AUSENTE" : image > 0 ? "DIFERENTE" : "ok", image == 0 ? "ok" : "FALHOU");
+        failures += image != 0;
+    }
+
+    ssd1306_display_clear_region(&display, 0, 0, 128, 64);
+    ssd1306_display_draw_image(&display, 4, 4, &asset_termometro);
+    ssd1306_display_draw_image(&display, 20, 6, &asset_alerta);
+    ssd1306_display_draw_text(&display, 4, 26, "0123456789", &asset_digitos_3x5);
+    ssd1306_display_draw_text(&display, 4, 35, "23.1-25.4 °C ?!", &asset_digitos_3x5);
+    ssd1306_display_flush_dirty(&display);
+    check_frame("assets", device, buffer + 1, 128, 8, 2, 1034);
+}
+
+// Transporte i2c: negociação de velocidade com um painel limitado a 400 kHz (i2c0) e outro que
+// aceita 1 MHz (i2c1), tempo de um quadro inteiro em cada velocidade e recuperação de falhas
+// simuladas (NACKs, barramento preso) sem perder o quadro. Como no SDK, a velocidade real fica
+// um pouco abaixo da pedida (399361 Hz para 400 kHz)
+static void scene_link() {
+    static const uint bus_speeds[] = { 1000000, 400000, 100000 };
+    static uint8_t buffer_32[ssd1306_framebuffer_size(128, 32)];
+    static uint8_t buffer_second[ssd1306_framebuffer_size(128, 32)];
+    static uint8_t buffer_64[ssd1306_framebuffer_size(128, 64)];
+    ssd1306_t slow, second, fast;
+    const uint fast_mode = ssd1306_emu_actual_baudrate(400000);
+
+    ssd1306_emu_device_t *device_32 = ssd1306_emu_attach(i2c0, 0x3D);
+    ssd1306_emu_device_t *device_64 = ssd1306_emu_attach(i2c1, 0x3B);
+    ssd1306_emu_attach(i2c0, 0x39);
+    device_32->max_baudrate = 400000;
+
+    // O segundo painel do i2c0 aceitaria 1 MHz, mas a busca começa no nível já negociado
+    // (400 kHz), não na velocidade real, que é menor que a nominal
+    ssd1306_display_init(&slow, 128, 32, false, 0x3D, i2c0, buffer_32);
+    ssd1306_display_init(&second, 128, 32, false, 0x39, i2c0, buffer_second);
+    ssd1306_display_init(&fast, 128, 64, false, 0x3B, i2c1, buffer_64);
+    uint speed_32 = ssd1306_transport_negotiate(&slow);
+    uint speed_second = ssd1306_transport_negotiate(&second);
+    uint speed_64 = ssd1306_transport_negotiate(&fast);
+    bool ok = speed_32 == fast_mode && speed_second == fast_mode && speed_64 == 1000000;
+    printf("%-14s i2c0 %u e %u Hz, i2c1 %u Hz  %s\n", "negotiate", speed_32, speed_second, speed_64, ok ? "ok" : "FALHOU");
+    failures += !ok;
+
+    ssd1306_emu_end_frame(device_32);
+    ssd1306_display_set_dirty_tracking(&slow, true);
+    ssd1306_display_draw_text(&slow, 2, 12, "i2c0 a 400 kHz", &ssd1306_font_5x8);
+    ssd1306_display_flush_dirty(&slow);
+    check_frame("link_400k", device_32, buffer_32 + 1, 128, 4, 2, 522);
+
+    // O mesmo quadro de 1 KiB em cada velocidade: o ganho do Fast-mode Plus medido em tempo de barramento
+    ssd1306_emu_end_frame(device_64);
+    ssd1306_display_draw_rect(&fast, 0, 0, 128, 64, ssd1306_mode_set);
+    ssd1306_display_draw_text(&fast, 8, 28, "i2c1 a 1 MHz", &ssd1306_font_5x8);
+    printf("%-14s", "frame_time");
+    for (int i = 0; i < count_of(bus_speeds); i++) {
+        ssd1306_transport_set_baudrate(i2c1, bus_speeds[i]);
+        ssd1306_send_data(&fast);
+        ssd1306_emu_traffic_t frame = ssd1306_emu_end_frame(device_64);
+        printf(" %u kHz %.2f ms", bus_speeds[i] / 1000, frame.bus_ns / 1e6);
+    }
+    printf("\n");
+    ssd1306_transport_set_baudrate(i2c1, 1000000);
+    ssd1306_transport_reset_stats(&fast);
+    ssd1306_emu_end_frame(device_64);
+
+    // Duas recusas: novas tentativas na mesma velocidade. Três: o controlador desce para 400 kHz.
+    // Um prazo estourado: nova tentativa. Em todos os casos o quadro chega inteiro
+    ssd1306_display_set_dirty_tracking(&fast, true);
+    ssd1306_display_clear_dirty(&fast); // o painel já tem o quadro inteiro
+    ssd1306_display_fill_circle(&fast, 100, 40, 12, ssd1306_mode_set);
+    device_64->nacks_pending = 2;
+    ssd1306_display_flush_dirty(&fast);
+    ssd1306_display_fill_rect(&fast, 8, 44, 60, 8, ssd1306_mode_set);
+    device_64->nacks_pending = 3;
+    ssd1306_display_flush_dirty(&fast);
+    ssd1306_display_draw_line(&fast, 8, 54, 120, 60, true);
+    device_64->timeouts_pending = 1;
+    ssd1306_display_flush_dirty(&fast);
+
+    struct ssd1306_link_stats link;
+    ssd1306_transport_get_stats(&fast, &link);
+    ok = link.nacks == 5 && link.timeouts == 1 && link.retries == 5 && link.failures == 0 &&
+         link.baudrate == fast_mode && ssd1306_emu_baudrate(i2c1) == fast_mode &&
+         link.transactions == device_64->frame.transactions && link.bytes == device_64->frame.bytes;
+    printf("%-14s %u NACK, %u timeouts, %u novas tentativas, %u abandonadas, %u kHz  %s\n", "link_faults",
+           link.nacks, link.timeouts, link.retries, link.failures, link.baudrate / 1000, ok ? "ok" : "FALHOU");
+    failures += !ok;
+    check_frame("link_faults", device_64, buffer_64 + 1, 128, 8, 16, 399);
+
+    // O serviço usa o i2c1 a seguir, na velocidade do temp_mda
+    ssd1306_transport_set_baudrate(i2c1, 400000);
+}
+
+// Serviço de display: o núcleo 1 (aqui, uma thread) executa os comandos da fila e envia os
+// quadros; o resultado tem de ser o mesmo do desenho direto, em qualquer intercalação
+static void scene_service() {
+    static uint8_t buffer[ssd1306_framebuffer_size(128, 64)];
+    static ssd1306_t display;
+
+    ssd1306_display_init(&display, 128, 64, false, 0x3E, i2c1, buffer);
+    ssd1306_emu_device_t *device = ssd1306_emu_device(i2c1, 0x3E);
+    ssd1306_emu_end_frame(device);
+
+    ssd1306_service_start(&display);
+    ssd1306_service_draw_rect(0, 0, 128, 64, ssd1306_mode_set);
+    for (int i = 0; i < 100; i++) {
+        char text[24];
+        snprintf(text, sizeof(text), "amostra %3d", i);
+        ssd1306_service_draw_text(10, 20, text, &ssd1306_font_5x8);
+        ssd1306_service_fill_rect(10, 40, i + 1, 6, ssd1306_mode_set);
+        ssd1306_service_flush();
+    }
+    while (!ssd1306_service_idle()) {
+        tight_loop_contents();
+    }
+
+    struct ssd1306_service_stats stats;
+    ssd1306_service_get_stats(&stats);
+    printf("%-14s %u comandos, fila máx. %u/%d, %u esperas (pior %u us), %u envios\n", "service",
+           stats.posted, stats.max_depth, ssd1306_service_queue_length, stats.stalls, stats.worst_stall_us, stats.flushes);
+    check_frame("service", device, buffer + 1, 128, 8, 596, 10149);
+
+    // Widgets pelo serviço, como no temp_mda: criados aqui e atualizados pelo núcleo 1. Uma
+    // leitura que muda um dígito envia só a célula desse glyph
+    static ssd1306_widget_t reading, gauge;
+    ssd1306_widget_init_number(&reading, &display, 46, 20, &ssd1306_font_5x8, 6, 2);
+    ssd1306_widget_init_bar(&gauge, &display, 10, 30, 108, 8, 0, 5000);
+    ssd1306_service_widget_set_number(&reading, 2531);
+    ssd1306_service_widget_set_bar(&gauge, 2531);
+    ssd1306_service_flush();
+    while (!ssd1306_service_idle()) {
+        tight_loop_contents();
+    }
+    ssd1306_emu_end_frame(device);
+
+    ssd1306_service_widget_set_number(&reading, 2538);
+    ssd1306_service_widget_set_bar(&gauge, 2538);
+    ssd1306_service_flush();
+    while (!ssd1306_service_idle()) {
+        tight_loop_contents();
+    }
+    check_frame("service_widget", device, buffer + 1, 128, 8, 4, 30);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "uso: %s <pasta golden> [--update]\n", argv[0]);
+        return 2;
+    }
+    golden_dir = argv[1];
+    update = argc > 2 && strcmp(argv[2], "--update") == 0;
+
+    ssd1306_emu_reset();
+    scene_temperature();
+    scene_graphics();
+    scene_bitmap();
+    scene_dual();
+    scene_scroll();
+    scene_console();
+    scene_ticker();
+    scene_widget();
+    scene_chart();
+    scene_assets();
+    scene_link();
+    scene_service(); // por último: a partir daqui o "núcleo 1" é dono do seu painel
+
+    if (failures) {
+        printf("%d verificação(ões) falharam\n", failures);
+        return 1;
+    }
+    printf("todas as verificações passaram\n");
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "flash_log.h"
+
+// Verificação do registro circular (flash_log.c) sobre uma flash simulada em RAM: para regiões
+// de vários tamanhos, grava de zero a mais de três voltas de setores e reinicia (um novo
+// flash_log_init sobre a mesma flash), conferindo que a busca binária acha o setor mais novo e
+// que os registros lidos são os esperados. Depois corta a energia no meio da gravação de um
+// setor (depois do apagamento, de parte das páginas) e confere que a partida volta ao setor
+// anterior, inclusive quando o setor interrompido é o 0 de uma nova volta
+// Uso: flash_check
+
+static int failures = 0;
+
+// Flash simulada; o "programa" termina no início dela e a região do registro vem depois
+uint8_t flash_emu_memory[PICO_FLASH_SIZE_BYTES] __attribute__((aligned(4)));
+extern char __flash_binary_end __attribute__((alias("flash_emu_memory")));
+
+#define LOG_OFFSET FLASH_SECTOR_SIZE
+#define LOG_MAX_SECTORS (PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE - 1)
+
+// Sem relógio: as durações nos contadores saem zeradas
+uint64_t time_us_64(void) {
+    return 0;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    assert(flash_offs % FLASH_SECTOR_SIZE == 0 && count % FLASH_SECTOR_SIZE == 0);
+    memset(flash_emu_memory + flash_offs, 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    assert(flash_offs % FLASH_PAGE_SIZE == 0 && count % FLASH_PAGE_SIZE == 0);
+    for (size_t i = 0; i < count; i++) {
+        flash_emu_memory[flash_offs + i] &= data[i];
+    }
+}
+
+// Falhas simuladas: operações até a queda de energia (-1 = sem queda; depois dela nada mais
+// chega à flash) e recusa da exclusividade (o outro núcleo não respondeu a tempo)
+static int operations_left = -1;
+static bool refuse = false;
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    if (refuse) {
+        return PICO_ERROR_TIMEOUT;
+    }
+    if (operations_left == 0) {
+        return PICO_OK;
+    }
+    if (operations_left > 0) {
+        operations_left--;
+    }
+    func(param);
+    return PICO_OK;
+}
+
+// Registro de teste: o índice e um padrão derivado dele
+struct record {
+    uint32_t index;
+    uint32_t pattern[3];
+};
+
+static struct record make_record(uint32_t index) {
+    struct record record = { index, { index * 2654435761u, ~index, index ^ 0x5A5A5A5A } };
+    return record;
+}
+
+static flash_log_t log_state;
+
+// Acrescenta 'count' registros a partir de 'first'; devolve quantos setores foram gravados
+// segundo flash_log_append
+static uint append_records(uint32_t first, uint32_t count) {
+    uint commits = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        struct record record = make_record(first + i);
+        flash_log_result_t result = flash_log_append(&log_state, &record);
+        if (result == flash_log_rejected) {
+            return commits;
+        }
+        commits += result == flash_log_committed;
+    }
+    return commits;
+}
+
+// Registro de idade 'age' igual ao de índice 'index'
+static bool read_matches(uint32_t age, uint32_t index) {
+    struct record record, expected = make_record(index);
+    return flash_log_read(&log_state, age, &record) && memcmp(&record, &expected, sizeof(record)) == 0;
+}
+
+// Reinicia sobre a flash atual e confere o que a partida encontrou: 'count' registros, do
+// mais novo, de índice 'newest', ao mais antigo, de índice 'oldest'
+static bool reboot_and_check(uint sectors, uint32_t count, uint32_t newest, uint32_t oldest) {
+    bool found = flash_log_init(&log_state, LOG_OFFSET, sectors, sizeof(struct record));
+    bool ok = found == (count > 0) && flash_log_count(&log_state) == count;
+
+    if (ok && count > 0) {
+        ok = read_matches(0, newest) && read_matches(count - 1, oldest);
+    }
+    struct record record;
+    return ok && !flash_log_read(&log_state, count, &record);
+}
+
+static uint32_t min_u32(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+
+// Grava 'commits' setores (e meio setor que fica só em RAM) numa região de 'sectors' setores
+// e reinicia
+static bool check_reboot(uint sectors, uint commits) {
+    memset(flash_emu_memory, 0xFF, sizeof(flash_emu_memory));
+    flash_log_init(&log_state, LOG_OFFSET, sectors, sizeof(struct record));
+    uint32_t capacity = log_state.capacity;
+
+    uint reported = append_records(0, commits * capacity + capacity / 2);
+    bool ok = reported == commits;
+    uint32_t written = commits * capacity;
+    uint32_t count = min_u32(commits, sectors) * capacity;
+    ok = ok && reboot_and_check(sectors, count, written - 1, written - count);
+
+    // Continua depois da partida: o setor seguinte tem a sequência seguinte
+    ok = ok && append_records(written, capacity) == 1;
+    count = min_u32(commits + 1, sectors) * capacity;
+    ok = ok && reboot_and_check(sectors, count, written + capacity - 1, written + capacity - count);
+    return ok;
+}
+
+// Como check_reboot, mas a energia cai depois de 'cut' operações da gravação do setor seguinte
+// (1 = só o apagamento, 2 = o apagamento e a primeira página...)
+static bool check_torn(uint sectors, uint commits, int cut) {
+    memset(flash_emu_memory, 0xFF, sizeof(flash_emu_memory));
+    flash_log_init(&log_state, LOG_OFFSET, sectors, sizeof(struct record));
+    uint32_t capacity = log_state.capacity;
+
+    append_records(0, commits * capacity);
+    uint32_t written = commits * capacity;
+    operations_left = cut;
+    append_records(written, capacity);
+    operations_left = -1;
+
+    // O setor interrompido é inválido e o que ele tinha da volta anterior foi apagado
+    uint32_t count = min_u32(commits, sectors - 1) * capacity;
+    bool ok = reboot_and_check(sectors, count, written - 1, written - count);
+
+    // Os registros do setor interrompido se perderam; o próximo reaproveita a posição, depois
+    // dos mesmos setores de antes
+    ok = ok && append_records(written + capacity, capacity) == 1;
+    ok = ok && reboot_and_check(sectors, count + capacity, written + 2 * capacity - 1,
+                                count ? written - count : written + capacity);
+    return ok;
+}
+
+// Gravação recusada: o registro que enche o setor entra, o seguinte é recusado até a flash
+// voltar a aceitar
+static bool check_refused(uint sectors) {
+    memset(flash_emu_memory, 0xFF, sizeof(flash_emu_memory));
+    flash_log_init(&log_state, LOG_OFFSET, sectors, sizeof(struct record));
+    uint32_t capacity = log_state.capacity;
+
+    bool ok = append_records(0, capacity - 1) == 0;
+    refuse = true;
+    struct record record = make_record(capacity - 1);
+    ok = ok && flash_log_append(&log_state, &record) == flash_log_buffered;
+    record = make_record(capacity);
+    ok = ok && flash_log_append(&log_state, &record) == flash_log_rejected;
+    refuse = false;
+    ok = ok && flash_log_append(&log_state, &record) == flash_log_committed;
+
+    struct flash_log_stats stats;
+    flash_log_get_stats(&log_state, &stats);
+    ok = ok && stats.failures == 2 && stats.commits == 1 && stats.records == capacity + 1;
+    return ok && reboot_and_check(sectors, capacity, capacity - 1, 0);
+}
+
+int main() {
+    static const uint region_sectors[] = { 1, 2, 3, 5, 8, LOG_MAX_SECTORS };
+    static const int cuts[] = { 1, 2, 16 };
+
+    for (int i = 0; i < count_of(region_sectors); i++) {
+        uint sectors = region_sectors[i];
+        int reboot_failed = 0, torn_failed = 0, runs = 0;
+
+        for (uint commits = 0; commits <= 3 * sectors + 1; commits++) {
+            reboot_failed += !check_reboot(sectors, commits);
+            for (int cut = 0; cut < count_of(cuts); cut++) {
+                torn_failed += !check_torn(sectors, commits, cuts[cut]);
+            }
+            runs++;
+        }
+        bool refused = check_refused(sectors);
+
+        bool ok = reboot_failed == 0 && torn_failed == 0 && refused;
+        printf("%2u setores  %2d partidas: %d erradas  gravações interrompidas: %d erradas  recusa %s  %s\n",
+               sectors, runs, reboot_failed, torn_failed, refused ? "ok" : "errada", ok ? "ok" : "FALHOU");
+        failures += !ok;
+    }
+
+    if (failures) {
+        printf("%d verificação(ões) falharam\n", failures);
+        return 1;
+    }
+    printf("todas as verificações passaram\n");
+    return 0;
+}
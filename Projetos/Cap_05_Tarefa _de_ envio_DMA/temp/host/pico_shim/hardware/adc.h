@@ -0,0 +1,29 @@
+// Substituto de hardware/adc.h: os registradores e as funções ficam num ADC simulado
+// (capture_check.c), que converte em rodízio e alimenta o DMA simulado
+#ifndef _HARDWARE_ADC_H
+#define _HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+#define ADC_CS_EN_BITS 0x00000001u
+#define ADC_CS_TS_EN_BITS 0x00000002u
+#define ADC_CS_READY_BITS 0x00000100u
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+} adc_hw_t;
+
+extern adc_hw_t adc_hw_instance;
+#define adc_hw (&adc_hw_instance)
+
+void adc_select_input(uint input);
+void adc_set_round_robin(uint input_mask);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_fifo_drain(void);
+void adc_run(bool run);
+
+#endif
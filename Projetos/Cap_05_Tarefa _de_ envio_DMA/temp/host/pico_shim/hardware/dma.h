@@ -0,0 +1,59 @@
+// Substituto de hardware/dma.h: canais simulados (capture_check.c) que copiam as amostras do
+// ADC simulado para a memória, com encadeamento e interrupção de fim de bloco
+#ifndef _HARDWARE_DMA_H
+#define _HARDWARE_DMA_H
+
+#include "pico/stdlib.h"
+
+#define DREQ_ADC 36
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint8_t size;
+    bool read_increment, write_increment;
+    bool ring_write;
+    uint8_t ring_bits;
+    uint8_t dreq;
+    uint8_t chain_to;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->size = (uint8_t) size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool increment) {
+    c->read_increment = increment;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool increment) {
+    c->write_increment = increment;
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+    c->ring_write = write;
+    c->ring_bits = (uint8_t) size_bits;
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = (uint8_t) dreq;
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->chain_to = (uint8_t) chain_to;
+}
+
+#endif
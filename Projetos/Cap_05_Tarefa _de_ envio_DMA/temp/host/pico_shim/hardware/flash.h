@@ -0,0 +1,21 @@
+// Substituto de hardware/flash.h: a flash é um vetor em RAM (flash_emu_memory, definido pelo
+// teste) e o XIP lê direto dele. Apagar leva os bytes a 0xFF; gravar só zera bits, como na flash
+#ifndef _HARDWARE_FLASH_H
+#define _HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+#ifndef PICO_FLASH_SIZE_BYTES
+#define PICO_FLASH_SIZE_BYTES (64 * 1024)
+#endif
+
+extern uint8_t flash_emu_memory[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t) flash_emu_memory)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
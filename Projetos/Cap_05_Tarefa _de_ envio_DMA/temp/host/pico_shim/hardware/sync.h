@@ -0,0 +1,28 @@
+// Substituto de hardware/sync.h: barreiras e eventos entre núcleos viram primitivas do compilador
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#include <sched.h>
+
+static inline void __dmb(void) {
+    __sync_synchronize();
+}
+
+static inline void __sev(void) {
+}
+
+// Sem evento para esperar: cede o processador em vez de dormir
+static inline void __wfe(void) {
+    sched_yield();
+}
+
+// Sem interrupções de verdade: os testes chamam os tratadores no mesmo fluxo
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void) status;
+}
+
+#endif
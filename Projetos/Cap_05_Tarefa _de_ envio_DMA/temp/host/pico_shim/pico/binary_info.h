@@ -0,0 +1 @@
+// Substituto vazio de pico/binary_info.h para compilar o driver no Linux
@@ -0,0 +1,10 @@
+// Substituto de pico/flash.h: no teste não há outro núcleo a pausar, e a função é executada
+// (ou recusada, ou interrompida, para simular uma queda de energia) pelo próprio teste
+#ifndef _PICO_FLASH_H
+#define _PICO_FLASH_H
+
+#include "pico/stdlib.h"
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+#endif
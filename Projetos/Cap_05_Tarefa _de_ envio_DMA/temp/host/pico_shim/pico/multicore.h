@@ -0,0 +1,26 @@
+// Substituto de pico/multicore.h: o "núcleo 1" é uma thread do sistema
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+
+#include <pthread.h>
+
+static void (*host_core1_entry)(void);
+
+static void *host_core1_thread(void *arg) {
+    (void) arg;
+    host_core1_entry();
+    return NULL;
+}
+
+static inline void multicore_launch_core1(void (*entry)(void)) {
+    pthread_t thread;
+    host_core1_entry = entry;
+    pthread_create(&thread, NULL, host_core1_thread, NULL);
+    pthread_detach(thread);
+}
+
+// Sem flash para gravar, ninguém pausa o "núcleo 1"
+static inline void multicore_lockout_victim_init(void) {
+}
+
+#endif
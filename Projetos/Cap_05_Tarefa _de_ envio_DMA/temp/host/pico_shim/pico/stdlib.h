@@ -0,0 +1,47 @@
+// Substituto mínimo de pico/stdlib.h para compilar o driver no Linux
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x ## u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+// No computador não há flash a evitar
+#define __not_in_flash_func(func_name) func_name
+
+// Códigos de erro de pico/error.h
+#define PICO_OK 0
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+static inline uint32_t time_us_32(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) (ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+// Relógio de 64 bits: cada programa que usa os módulos do ADC define o seu (os testes usam um
+// relógio simulado, para que os intervalos medidos sejam determinísticos)
+uint64_t time_us_64(void);
+
+static inline void tight_loop_contents(void) {
+}
+
+// Só o tipo de pico/time.h, para os headers do driver; os módulos que usam timers
+// (ssd1306_gray.c) não entram no build do computador
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *timer);
+struct repeating_timer {
+    int64_t delay_us;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+#endif
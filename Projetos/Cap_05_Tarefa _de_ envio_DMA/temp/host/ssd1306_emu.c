@@ -0,0 +1,400 @@
+#include <string.h>
+#include "ssd1306_emu.h"
+
+// Barramento i2c de mentira: cada transação é entregue ao dispositivo (controlador, endereço)
+i2c_inst_t i2c0_inst = { 0 };
+i2c_inst_t i2c1_inst = { 1 };
+
+static ssd1306_emu_device_t devices[ssd1306_emu_max_devices];
+static FILE *capture = NULL;
+
+// Velocidade de cada controlador; começa na que o temp_mda passa a i2c_init
+static uint port_baudrate[2] = { ssd1306_emu_actual_baudrate(400000), ssd1306_emu_actual_baudrate(400000) };
+
+// Esquece todos os dispositivos (a GDDRAM volta a zero, como após ligar o painel)
+void ssd1306_emu_reset() {
+    memset(devices, 0, sizeof(devices));
+    port_baudrate[0] = port_baudrate[1] = ssd1306_emu_actual_baudrate(400000);
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    port_baudrate[i2c->index] = ssd1306_emu_actual_baudrate(baudrate);
+    return port_baudrate[i2c->index];
+}
+
+// Velocidade atual do controlador, em Hz
+uint ssd1306_emu_baudrate(i2c_inst_t *i2c) {
+    return port_baudrate[i2c->index];
+}
+
+// Registra cada transação numa linha de texto ("i2c1 3C: 00 21 00 7F ..."); NULL desliga
+void ssd1306_emu_capture(FILE *file) {
+    capture = file;
+}
+
+// Dispositivo no endereço 'address' do controlador 'i2c', criado no primeiro acesso
+static ssd1306_emu_device_t *ssd1306_emu_lookup(int port, uint8_t address, bool create) {
+    for (int i = 0; i < ssd1306_emu_max_devices; i++) {
+        if (devices[i].present && devices[i].port == port && devices[i].address == address) {
+            return &devices[i];
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    for (int i = 0; i < ssd1306_emu_max_devices; i++) {
+        ssd1306_emu_device_t *device = &devices[i];
+        if (!device->present) {
+            // Valores de reset do datasheet
+            device->present = true;
+            device->port = port;
+            device->address = address;
+            device->memory_mode = 2;
+            device->column_end = ssd1306_emu_columns - 1;
+            device->page_end = ssd1306_emu_pages - 1;
+            device->mux_ratio = 63;
+            device->contrast = 0x7F;
+            device->com_pins = 0x12;
+            return device;
+        }
+    }
+    return NULL;
+}
+
+// Dispositivo que já recebeu alguma transação, ou NULL
+ssd1306_emu_device_t *ssd1306_emu_device(i2c_inst_t *i2c, uint8_t address) {
+    return ssd1306_emu_lookup(i2c->index, address, false);
+}
+
+// Liga um dispositivo ao barramento antes da primeira transação (ex.: para configurar falhas)
+ssd1306_emu_device_t *ssd1306_emu_attach(i2c_inst_t *i2c, uint8_t address) {
+    return ssd1306_emu_lookup(i2c->index, address, true);
+}
+
+// Parâmetros esperados após cada comando
+static int ssd1306_emu_param_count(uint8_t command) {
+    switch (command) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+// Executa um comando já com todos os parâmetros
+static void ssd1306_emu_execute(ssd1306_emu_device_t *device, uint8_t command, const uint8_t *params) {
+    if (command <= 0x0F) {
+        device->column = (device->column & 0xF0) | command;
+    }
+    else if (command <= 0x1F) {
+        device->column = (device->column & 0x0F) | ((command & 0x07) << 4);
+    }
+    else if (command >= 0x40 && command <= 0x7F) {
+        device->start_line = command & 0x3F;
+    }
+    else if (command >= 0xB0 && command <= 0xB7) {
+        device->page = command & 0x07;
+    }
+    else switch (command) {
+        case 0x20: device->memory_mode = params[0] & 0x03; break;
+        case 0x21:
+            device->column_start = device->column = params[0] & 0x7F;
+            device->column_end = params[1] & 0x7F;
+            break;
+        case 0x22:
+            device->page_start = device->page = params[0] & 0x07;
+            device->page_end = params[1] & 0x07;
+            break;
+        case 0x26: case 0x27:
+            device->scroll_left = command == 0x27;
+            device->scroll_start_page = params[1] & 0x07;
+            device->scroll_end_page = params[3] & 0x07;
+            device->scroll_vertical_offset = 0;
+            break;
+        case 0x29: case 0x2A:
+            device->scroll_left = command == 0x2A;
+            device->scroll_start_page = params[1] & 0x07;
+            device->scroll_end_page = params[3] & 0x07;
+            device->scroll_vertical_offset = params[4] & 0x3F;
+            break;
+        case 0x2E: device->scroll_active = false; break;
+        case 0x2F: device->scroll_active = true; device->scroll_row = 0; break;
+        case 0x81: device->contrast = params[0]; break;
+        case 0x8D: device->charge_pump = params[0] & 0x04; break;
+        case 0xA0: case 0xA1: device->segment_remap = command & 0x01; break;
+        case 0xA3: break;
+        case 0xA4: case 0xA5: device->entire_on = command & 0x01; break;
+        case 0xA6: case 0xA7: device->inverse = command & 0x01; break;
+        case 0xA8: device->mux_ratio = params[0] & 0x3F; break;
+        case 0xAE: case 0xAF: device->display_on = command & 0x01; break;
+        case 0xC0: case 0xC8: device->com_flip = command & 0x08; break;
+        case 0xD3: device->display_offset = params[0] & 0x3F; break;
+        case 0xDA: device->com_pins = params[0]; break;
+        case 0xD5: case 0xD9: case 0xDB: case 0xE3: break;
+        default: device->errors++; break;
+    }
+}
+
+// Um byte no modo de comandos: inicia um comando ou completa os parâmetros do anterior
+static void ssd1306_emu_command_byte(ssd1306_emu_device_t *device, uint8_t byte) {
+    if (device->params_got < device->params_needed) {
+        device->params[device->params_got++] = byte;
+    }
+    else {
+        device->command = byte;
+        device->params_needed = ssd1306_emu_param_count(byte);
+        device->params_got = 0;
+    }
+
+    if (device->params_got == device->params_needed) {
+        ssd1306_emu_execute(device, device->command, device->params);
+        device->params_needed = device->params_got = 0;
+    }
+}
+
+// Um byte de dados: escreve na GDDRAM e avança o ponteiro conforme o modo de endereçamento
+static void ssd1306_emu_data_byte(ssd1306_emu_device_t *device, uint8_t byte) {
+    device->gddram[device->page][device->column] = byte;
+
+    if (device->memory_mode == 1) {
+        if (device->page++ >= device->page_end) {
+            device->page = device->page_start;
+            if (device->column++ >= device->column_end) {
+                device->column = device->column_start;
+            }
+        }
+    }
+    else if (device->memory_mode == 0) {
+        if (device->column++ >= device->column_end) {
+            device->column = device->column_start;
+            if (device->page++ >= device->page_end) {
+                device->page = device->page_start;
+            }
+        }
+    }
+    else if (device->column++ >= device->column_end) {
+        device->column = device->column_start;
+    }
+}
+
+// Soma tempo de barramento ao dispositivo
+static void ssd1306_emu_bus_time(ssd1306_emu_device_t *device, uint64_t ns) {
+    device->total.bus_ns += ns;
+    device->frame.bus_ns += ns;
+}
+
+// Duração de 'bits' na velocidade do controlador
+static uint64_t ssd1306_emu_bits_ns(int port, uint64_t bits) {
+    return bits * 1000000000ull / port_baudrate[port];
+}
+
+// Cada transação começa por um byte de controle: Co (bit 7) = 1 vale só para o próximo byte,
+// Co = 0 vale para o resto da transação; D/C (bit 6) escolhe entre dados e comandos
+// 'prefix' (se não for negativo) é um byte enviado antes de 'src' na mesma transação, como o
+// byte de controle escrito no FIFO por ssd1306_fifo_write_timeout_us
+static int ssd1306_emu_write(i2c_inst_t *i2c, uint8_t addr, int prefix, const uint8_t *src, size_t len, uint timeout_us) {
+    ssd1306_emu_device_t *device = ssd1306_emu_lookup(i2c->index, addr, true);
+
+    if (capture) {
+        fprintf(capture, "i2c%d %02X:", i2c->index, addr);
+        if (prefix >= 0) {
+            fprintf(capture, " %02X", prefix);
+        }
+        for (size_t i = 0; i < len; i++) {
+            fprintf(capture, " %02X", src[i]);
+        }
+        fprintf(capture, "\n");
+    }
+    size_t total = len + (prefix >= 0);
+    if (!device) {
+        return total;
+    }
+
+    // Falhas simuladas: um NACK custa o byte de endereço; um barramento preso, o prazo inteiro
+    if (device->timeouts_pending > 0) {
+        device->timeouts_pending--;
+        ssd1306_emu_bus_time(device, (uint64_t) timeout_us * 1000);
+        return PICO_ERROR_TIMEOUT;
+    }
+    if (device->nacks_pending > 0 || (device->max_baudrate && port_baudrate[i2c->index] > device->max_baudrate)) {
+        if (device->nacks_pending > 0) {
+            device->nacks_pending--;
+        }
+        ssd1306_emu_bus_time(device, ssd1306_emu_bits_ns(i2c->index, 9 + 2));
+        return PICO_ERROR_GENERIC;
+    }
+
+    device->total.transactions++;
+    device->total.bytes += total + 1;
+    device->frame.transactions++;
+    device->frame.bytes += total + 1;
+    ssd1306_emu_bus_time(device, ssd1306_emu_bits_ns(i2c->index, (uint64_t) (total + 1) * 9 + 2));
+
+    size_t i = 0;
+    while (i < len || prefix >= 0) {
+        uint8_t control = prefix >= 0 ? prefix : src[i++];
+        prefix = -1;
+        bool single = control & 0x80;
+        bool data = control & 0x40;
+
+        if (control & 0x3F) {
+            device->errors++;
+        }
+
+        size_t end = single ? (i < len ? i + 1 : i) : len;
+        for (; i < end; i++) {
+            if (data) {
+                ssd1306_emu_data_byte(device, src[i]);
+            }
+            else {
+                ssd1306_emu_command_byte(device, src[i]);
+            }
+        }
+    }
+
+    return total;
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us) {
+    return ssd1306_emu_write(i2c, addr, -1, src, len, timeout_us);
+}
+
+// No firmware, a escrita direta no FIFO do controlador (ssd1306_async.c)
+int ssd1306_fifo_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t control, const uint8_t *data, size_t length, uint timeout_us) {
+    return ssd1306_emu_write(i2c, addr, control, data, length, timeout_us);
+}
+
+// Sem prazo, uma transação presa no hardware nunca termina; aqui ela falha como no prazo de 1 s
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    return i2c_write_timeout_us(i2c, addr, src, len, nostop, 1000000);
+}
+
+// Encerra um quadro: retorna o tráfego desde o quadro anterior
+ssd1306_emu_traffic_t ssd1306_emu_end_frame(ssd1306_emu_device_t *device) {
+    ssd1306_emu_traffic_t frame = device->frame;
+    memset(&device->frame, 0, sizeof(device->frame));
+    return frame;
+}
+
+// Avança o scrolling ativo em 'steps' colunas. No SSD1306 o scrolling gira o próprio conteúdo
+// da GDDRAM das páginas escolhidas (e, no modo vertical, também a linha inicial)
+void ssd1306_emu_scroll_step(ssd1306_emu_device_t *device, int steps) {
+    if (!device->scroll_active) {
+        return;
+    }
+
+    for (int step = 0; step < steps; step++) {
+        for (int page = device->scroll_start_page; page <= device->scroll_end_page; page++) {
+            uint8_t *row = device->gddram[page];
+            if (device->scroll_left) {
+                uint8_t first = row[0];
+                memmove(row, row + 1, ssd1306_emu_columns - 1);
+                row[ssd1306_emu_columns - 1] = first;
+            }
+            else {
+                uint8_t last = row[ssd1306_emu_columns - 1];
+                memmove(row + 1, row, ssd1306_emu_columns - 1);
+                row[0] = last;
+            }
+        }
+        device->scroll_row = (device->scroll_row + device->scroll_vertical_offset) & 0x3F;
+    }
+}
+
+// Linhas visíveis do painel (razão de multiplexação + 1)
+int ssd1306_emu_height(const ssd1306_emu_device_t *device) {
+    return device->mux_ratio + 1;
+}
+
+// Pixel (x, y) como visto no painel. A orientação de referência é a que os módulos usam
+// (remapeamento de segmentos 0xA1 + varredura de COM invertida 0xC8): RAM sem espelhamento
+bool ssd1306_emu_pixel(const ssd1306_emu_device_t *device, int x, int y) {
+    if (!device->display_on) {
+        return false;
+    }
+    if (device->entire_on) {
+        return true;
+    }
+
+    int line = device->com_flip ? y : device->mux_ratio - y;
+    int row = (line + device->start_line + device->display_offset + device->scroll_row) & 0x3F;
+    int column = device->segment_remap ? x : ssd1306_emu_columns - 1 - x;
+    bool on = device->gddram[row / 8][column] & (1 << (row % 8));
+
+    return on != device->inverse;
+}
+
+// Compara a GDDRAM com um framebuffer no layout de páginas; retorna o número de bytes diferentes
+int ssd1306_emu_compare_ram(const ssd1306_emu_device_t *device, const uint8_t *pixels, int width, int pages) {
+    int mismatches = 0;
+    for (int page = 0; page < pages; page++) {
+        for (int column = 0; column < width; column++) {
+            mismatches += device->gddram[page][column] != pixels[page * width + column];
+        }
+    }
+    return mismatches;
+}
+
+// Imagem do painel em PBM binário (P4), 1 = pixel aceso
+bool ssd1306_emu_write_pbm(const ssd1306_emu_device_t *device, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    int height = ssd1306_emu_height(device);
+    fprintf(file, "P4\n%d %d\n", ssd1306_emu_columns, height);
+    for (int y = 0; y < height; y++) {
+        uint8_t row[ssd1306_emu_columns / 8] = { 0 };
+        for (int x = 0; x < ssd1306_emu_columns; x++) {
+            if (ssd1306_emu_pixel(device, x, y)) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+
+    fclose(file);
+    return true;
+}
+
+// Compara a imagem do painel com um PBM P4. Retorna os pixels diferentes, ou -1 se o arquivo
+// não existir ou não tiver as dimensões do painel
+int ssd1306_emu_compare_pbm(const ssd1306_emu_device_t *device, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+
+    int width, height;
+    int height_expected = ssd1306_emu_height(device);
+    if (fscanf(file, "P4 %d %d", &width, &height) != 2 || fgetc(file) == EOF ||
+        width != ssd1306_emu_columns || height != height_expected) {
+        fclose(file);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int y = 0; y < height; y++) {
+        uint8_t row[ssd1306_emu_columns / 8];
+        if (fread(row, 1, sizeof(row), file) != sizeof(row)) {
+            fclose(file);
+            return -1;
+        }
+        for (int x = 0; x < width; x++) {
+            bool golden = row[x / 8] & (0x80 >> (x % 8));
+            mismatches += golden != ssd1306_emu_pixel(device, x, y);
+        }
+    }
+
+    fclose(file);
+    return mismatches;
+}
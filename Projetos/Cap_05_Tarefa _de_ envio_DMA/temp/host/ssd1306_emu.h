@@ -0,0 +1,78 @@
+// Emulador do SSD1306 para o build no computador: substitui as escritas i2c do SDK e decodifica o
+// fluxo de bytes de controle, comandos e dados numa GDDRAM simulada, por controlador e endereço
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#define ssd1306_emu_max_devices 16
+#define ssd1306_emu_columns 128
+#define ssd1306_emu_pages 8
+
+// Velocidade real para uma pedida, arredondada como no SDK: o período do SCL é um número
+// inteiro de ciclos de clk_sys (a 125 MHz, pedir 400 kHz dá 399361 Hz)
+#define ssd1306_emu_clk_sys 125000000u
+#define ssd1306_emu_actual_baudrate(baudrate) (ssd1306_emu_clk_sys / ((ssd1306_emu_clk_sys + (baudrate) / 2) / (baudrate)))
+
+// Tráfego acumulado (bytes incluem o byte de endereço de cada transação, como no driver) e o
+// tempo que ele ocuparia no barramento na velocidade do controlador, tentativas recusadas inclusive
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint64_t bus_ns;
+} ssd1306_emu_traffic_t;
+
+typedef struct {
+    bool present;
+    int port;        // 0 = i2c0, 1 = i2c1
+    uint8_t address;
+
+    uint8_t gddram[ssd1306_emu_pages][ssd1306_emu_columns];
+
+    // Endereçamento: 0 = horizontal, 1 = vertical, 2 = página
+    uint8_t memory_mode;
+    uint8_t column_start, column_end, page_start, page_end;
+    uint8_t column, page;
+
+    // Configuração do painel
+    uint8_t start_line, display_offset, mux_ratio, contrast, com_pins;
+    bool segment_remap, com_flip, inverse, entire_on, display_on, charge_pump;
+
+    // Scrolling horizontal (0x26/0x27) e vertical (0x29/0x2A), avançado por ssd1306_emu_scroll_step
+    bool scroll_active;
+    bool scroll_left;
+    uint8_t scroll_start_page, scroll_end_page, scroll_vertical_offset;
+    uint8_t scroll_row; // deslocamento vertical acumulado
+
+    // Comando aguardando parâmetros (que podem vir em transações seguintes)
+    uint8_t command;
+    uint8_t params[7];
+    int params_needed, params_got;
+
+    // Falhas simuladas: velocidade máxima aceita (0 = qualquer uma; acima dela o painel não
+    // responde), próximas transações recusadas com NACK e próximas que ficam presas até o prazo
+    uint32_t max_baudrate;
+    int nacks_pending;
+    int timeouts_pending;
+
+    ssd1306_emu_traffic_t total;
+    ssd1306_emu_traffic_t frame; // desde o último ssd1306_emu_end_frame
+    uint32_t errors;             // bytes de controle inválidos, comandos desconhecidos
+} ssd1306_emu_device_t;
+
+extern void ssd1306_emu_reset();
+extern void ssd1306_emu_capture(FILE *file);
+extern ssd1306_emu_device_t *ssd1306_emu_device(i2c_inst_t *i2c, uint8_t address);
+extern ssd1306_emu_device_t *ssd1306_emu_attach(i2c_inst_t *i2c, uint8_t address);
+extern uint ssd1306_emu_baudrate(i2c_inst_t *i2c);
+extern ssd1306_emu_traffic_t ssd1306_emu_end_frame(ssd1306_emu_device_t *device);
+extern void ssd1306_emu_scroll_step(ssd1306_emu_device_t *device, int steps);
+extern bool ssd1306_emu_pixel(const ssd1306_emu_device_t *device, int x, int y);
+extern int ssd1306_emu_height(const ssd1306_emu_device_t *device);
+extern int ssd1306_emu_compare_ram(const ssd1306_emu_device_t *device, const uint8_t *pixels, int width, int pages);
+extern bool ssd1306_emu_write_pbm(const ssd1306_emu_device_t *device, const char *path);
+extern int ssd1306_emu_compare_pbm(const ssd1306_emu_device_t *device, const char *path);
+
+#endif
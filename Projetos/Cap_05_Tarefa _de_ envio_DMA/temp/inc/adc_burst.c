@@ -0,0 +1,204 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "adc_burst.h"
+
+// Cada rajada: o alarme (interrupção do timer) liga o ADC (e o sensor de temperatura, se for a
+// entrada 4), espera ele ficar pronto e dispara um canal de DMA para 'samples' conversões
+// seguidas, a 500 mil amostras/s: quanto mais curta a rajada, menos tempo o ADC fica ligado.
+// O fim do DMA (DMA_IRQ_0) para e desliga o ADC, agenda o próximo alarme (período fixo a partir
+// do anterior, sem deriva) e publica a rajada. O núcleo espera em __wfi com as interrupções
+// mascaradas, o que fecha a janela entre testar a rajada e dormir: uma interrupção pendente
+// ainda acorda o WFI, e o tratador roda assim que elas são liberadas
+
+static uint16_t buffer[adc_burst_settle_samples + adc_burst_max_samples];
+
+static int channel = -1;
+static int alarm = -1;
+static uint burst_input = 0;
+static uint burst_length = 0;
+static uint64_t period_us = 0, next_us = 0, started_us = 0;
+
+// Rajada em andamento e a última completa (escritos nas interrupções)
+static uint64_t burst_started_us = 0;
+static volatile uint32_t completed = 0;
+static volatile uint32_t last_adc_on_us = 0;
+static uint32_t consumed = 0;
+static uint64_t waited_us = 0; // fim da espera anterior, para medir o tempo acordado
+
+static uint32_t missed = 0, overrun = 0, wakeups = 0;
+static uint64_t total_adc_on_us = 0, total_sleep_us = 0, total_awake_us = 0;
+
+// Bits de cs que ligam o ADC (e o sensor de temperatura)
+static inline uint32_t adc_burst_enable_bits() {
+    return ADC_CS_EN_BITS | (burst_input == 4 ? ADC_CS_TS_EN_BITS : 0);
+}
+
+// Agenda o próximo alarme; períodos que já passaram (uma rajada atrasada) são pulados
+static void adc_burst_schedule() {
+    uint64_t now = time_us_64();
+
+    next_us += period_us;
+    while (next_us <= now) {
+        next_us += period_us;
+        missed++;
+    }
+    if (hardware_alarm_set_target(alarm, from_us_since_boot(next_us))) {
+        missed++;
+        next_us += period_us;
+        hardware_alarm_set_target(alarm, from_us_since_boot(next_us));
+    }
+}
+
+// Alarme: liga o ADC e começa a rajada
+static void adc_burst_on_alarm(uint alarm_num) {
+    (void) alarm_num;
+    burst_started_us = time_us_64();
+
+    hw_set_bits(&adc_hw->cs, adc_burst_enable_bits());
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) {
+        tight_loop_contents();
+    }
+    adc_select_input(burst_input);
+    adc_fifo_drain();
+    dma_channel_set_write_addr(channel, buffer, false);
+    dma_channel_set_trans_count(channel, adc_burst_settle_samples + burst_length, true);
+    adc_run(true);
+}
+
+// Fim do DMA: desliga o ADC, publica a rajada e agenda a próxima
+static void adc_burst_irq_handler() {
+    if (!(dma_hw->ints0 & (1u << channel))) {
+        return;
+    }
+    dma_hw->ints0 = 1u << channel;
+
+    adc_run(false);
+    adc_fifo_drain();
+    hw_clear_bits(&adc_hw->cs, adc_burst_enable_bits());
+
+    uint32_t on = (uint32_t) (time_us_64() - burst_started_us);
+    last_adc_on_us = on;
+    total_adc_on_us += on;
+    if (completed != consumed) {
+        overrun++;
+    }
+    completed = completed + 1;
+
+    adc_burst_schedule();
+}
+
+// Inicia as rajadas: 'samples' amostras da entrada 'input' a cada 'period_us'. O ADC já deve ter
+// sido inicializado (adc_init); entre as rajadas ele fica desligado
+void adc_burst_start(uint input, uint samples, uint32_t period_us_) {
+    assert(samples > 0 && samples <= adc_burst_max_samples && period_us_ > 0);
+
+    burst_input = input;
+    burst_length = samples;
+    period_us = period_us_;
+    completed = consumed = 0;
+    missed = overrun = wakeups = 0;
+    total_adc_on_us = total_sleep_us = total_awake_us = 0;
+
+    hw_clear_bits(&adc_hw->cs, ADC_CS_EN_BITS | ADC_CS_TS_EN_BITS);
+    adc_set_round_robin(0);
+    adc_hw->div = 0; // conversões seguidas
+    adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits
+
+    channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(channel, &config, buffer, &adc_hw->fifo, 0, false);
+    dma_channel_set_irq0_enabled(channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, adc_burst_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm, adc_burst_on_alarm);
+    started_us = waited_us = time_us_64();
+    next_us = started_us;
+    adc_burst_schedule();
+}
+
+// Para as rajadas, libera o alarme e o canal e deixa o ADC desligado
+void adc_burst_stop() {
+    if (channel < 0) {
+        return;
+    }
+
+    hardware_alarm_cancel(alarm);
+    hardware_alarm_set_callback(alarm, NULL);
+    hardware_alarm_unclaim(alarm);
+    alarm = -1;
+
+    adc_run(false);
+    dma_channel_set_irq0_enabled(channel, false);
+    dma_channel_abort(channel);
+    dma_hw->ints0 = 1u << channel;
+    dma_channel_unclaim(channel);
+    channel = -1;
+    irq_remove_handler(DMA_IRQ_0, adc_burst_irq_handler);
+
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    hw_clear_bits(&adc_hw->cs, ADC_CS_EN_BITS | ADC_CS_TS_EN_BITS);
+}
+
+// Dorme em __wfi até a próxima rajada completa (retorna na hora se já houver uma não lida).
+// As amostras valem até o início da rajada seguinte. Retorna o número de amostras
+uint adc_burst_wait(const uint16_t **samples, struct adc_burst_record *record) {
+    uint64_t start = time_us_64();
+    uint32_t awake = (uint32_t) (start - waited_us);
+    uint32_t woken = 0;
+
+    while (true) {
+        uint32_t irq = save_and_disable_interrupts();
+        bool ready = completed != consumed;
+        if (!ready) {
+            __wfi();
+        }
+        restore_interrupts(irq);
+        if (ready) {
+            break;
+        }
+        woken++;
+    }
+
+    waited_us = time_us_64();
+    uint32_t slept = (uint32_t) (waited_us - start);
+    consumed = completed;
+    total_sleep_us += slept;
+    total_awake_us += awake;
+    wakeups += woken;
+
+    if (record) {
+        record->sequence = consumed - 1;
+        record->adc_on_us = last_adc_on_us;
+        record->sleep_us = slept;
+        record->awake_us = awake;
+        record->wakeups = woken;
+    }
+    *samples = buffer + adc_burst_settle_samples;
+    return burst_length;
+}
+
+// Totais desde o início. Leia no núcleo que iniciou as rajadas
+void adc_burst_get_stats(struct adc_burst_stats *out) {
+    uint32_t irq = save_and_disable_interrupts();
+    out->bursts = completed;
+    out->missed = missed;
+    out->overrun = overrun;
+    out->adc_on_us = total_adc_on_us;
+    restore_interrupts(irq);
+    out->sleep_us = total_sleep_us;
+    out->awake_us = total_awake_us;
+    out->wakeups = wakeups;
+    out->elapsed_us = time_us_64() - started_us;
+}
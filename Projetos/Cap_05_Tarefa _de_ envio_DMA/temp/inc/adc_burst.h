@@ -0,0 +1,38 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_burst_inc_h
+#define adc_burst_inc_h
+
+// Aquisição em rajadas com baixo consumo: um alarme de hardware liga o ADC e dispara o DMA a
+// cada período, o fim do DMA desliga o ADC e acorda o núcleo, e entre as rajadas o núcleo fica
+// em __wfi. Alternativa à aquisição contínua (adc_capture): as duas não rodam ao mesmo tempo
+#define adc_burst_max_samples 2048
+#define adc_burst_settle_samples 16 // descartadas no início de cada rajada (o sensor acaba de ser ligado)
+
+// Tempos de uma rajada
+struct adc_burst_record {
+    uint32_t sequence;
+    uint32_t adc_on_us; // ADC ligado: do alarme ao fim do DMA
+    uint32_t sleep_us;  // núcleo em adc_burst_wait esperando esta rajada
+    uint32_t awake_us;  // núcleo fora de adc_burst_wait desde a rajada anterior (processamento)
+    uint32_t wakeups;   // vezes que outra interrupção acordou o núcleo durante a espera
+};
+
+// Totais desde o início; duty do ADC = adc_on_us / elapsed_us, do núcleo = awake_us / elapsed_us
+struct adc_burst_stats {
+    uint32_t bursts;
+    uint32_t missed;    // rajadas puladas (o alarme já tinha passado ao ser agendado)
+    uint32_t overrun;   // rajadas sobrescritas antes de serem lidas
+    uint64_t adc_on_us;
+    uint64_t sleep_us;
+    uint64_t awake_us;
+    uint64_t elapsed_us;
+    uint32_t wakeups;
+};
+
+extern void adc_burst_start(uint input, uint samples, uint32_t period_us);
+extern void adc_burst_stop();
+extern uint adc_burst_wait(const uint16_t **samples, struct adc_burst_record *record);
+extern void adc_burst_get_stats(struct adc_burst_stats *out);
+
+#endif
@@ -0,0 +1,338 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/sync.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "adc_capture.h"
+
+// Aquisição contínua: o ADC roda sem parar (por padrão com clkdiv 0: uma conversão a cada 96
+// ciclos de 48 MHz, 500 mil amostras/s; adc_capture_set_rate escolhe taxas menores) e dois
+// canais de DMA se revezam, cada um enchendo o seu bloco e disparando o outro ao terminar
+// (channel_config_set_chain_to). A interrupção de fim de bloco só entrega o bloco pronto: a
+// escrita de cada canal é um anel do tamanho do bloco (channel_config_set_ring), e o contador
+// de transferências é recarregado a cada disparo, então nenhum registrador precisa ser
+// rearmado e um atraso na interrupção nunca escreve fora do bloco.
+// Com várias entradas, o ADC as converte em rodízio (adc_set_round_robin) e o mesmo fluxo de
+// DMA traz as amostras intercaladas; a interrupção as separa por entrada, num anel de amostras
+// recentes de cada uma, e as entrega à aplicação entrada por entrada.
+// Se a interrupção atrasar a ponto de encontrar os dois blocos prontos, o DMA já voltou a um
+// deles (talvez mais de uma vez) e a posição no rodízio se perdeu: os blocos são descartados e a
+// aquisição recomeça da primeira entrada
+
+// Cada bloco alinhado ao próprio tamanho, como o anel de escrita do DMA exige
+static uint16_t blocks[2][adc_capture_block_length] __attribute__((aligned(adc_capture_block_length * sizeof(uint16_t))));
+
+static int channel[2] = { -1, -1 };
+static dma_channel_config config[2];
+static adc_capture_callback_t block_callback = NULL;
+static int next = 0; // bloco que termina a seguir
+
+// Entradas do rodízio em ordem crescente (a ordem de conversão do ADC) e a posição no rodízio
+// da primeira amostra do próximo bloco
+static uint8_t order[adc_capture_inputs];
+static uint order_length = 0;
+static uint phase = 0;
+
+// Amostras de uma entrada separadas do fluxo (reaproveitado por todas as entradas)
+static uint16_t scratch[adc_capture_block_length];
+
+// Anel de amostras recentes e contadores de cada entrada
+struct adc_capture_ring {
+    uint16_t samples[adc_capture_ring_length];
+    uint64_t count;   // amostras já recebidas (a próxima vai para count % tamanho do anel)
+    uint64_t last_us;
+};
+static struct adc_capture_ring rings[adc_capture_inputs];
+
+// Divisor do ADC em ponto fixo com 8 bits de fração, no formato do registrador DIV: o ADC
+// inicia uma conversão a cada 1 + DIV ciclos de 48 MHz (ao menos 96, a duração de uma conversão;
+// 0 = conversões seguidas)
+static uint32_t clkdiv_q8 = 0;
+
+static uint32_t block_count = 0, overruns = 0, lost_blocks = 0;
+static uint64_t sample_count = 0, started_us = 0, irq_us = 0;
+static uint64_t last_block_us = 0; // entrega mais recente (ou início)
+
+// Período de conversão do ADC em ciclos de 48 MHz, com 8 bits de fração
+static uint32_t adc_capture_period_q8() {
+    return clkdiv_q8 ? clkdiv_q8 + 256 : 96 << 8;
+}
+
+// Duração de um bloco, em ns
+static uint64_t adc_capture_block_ns() {
+    return (uint64_t) adc_capture_period_q8() * 125 * adc_capture_block_length / 1536;
+}
+
+// Guarda as amostras de uma entrada no seu anel e as entrega à aplicação
+static void adc_capture_store(uint input, const uint16_t *samples, uint count, uint64_t now) {
+    struct adc_capture_ring *ring = &rings[input];
+    uint start = count > adc_capture_ring_length ? count - adc_capture_ring_length : 0;
+
+    for (uint i = start; i < count; i++) {
+        ring->samples[(ring->count + i) & (adc_capture_ring_length - 1)] = samples[i];
+    }
+    ring->count += count;
+    ring->last_us = now;
+
+    if (block_callback) {
+        block_callback(input, samples, count);
+    }
+}
+
+// Separa um bloco intercalado por entrada: a amostra i pertence a order[(phase + i) % n]
+static void adc_capture_deliver(const uint16_t *samples, uint64_t now) {
+    if (order_length == 1) {
+        adc_capture_store(order[0], samples, adc_capture_block_length, now);
+        return;
+    }
+
+    for (uint position = 0; position < order_length; position++) {
+        uint n = 0;
+        for (uint i = (position + order_length - phase) % order_length; i < adc_capture_block_length; i += order_length) {
+            scratch[n++] = samples[i];
+        }
+        adc_capture_store(order[position], scratch, n, now);
+    }
+    phase = (phase + adc_capture_block_length) % order_length;
+}
+
+// Para o ADC e os dois canais, sem liberá-los. O encadeamento é desfeito antes do abort, para
+// que o canal abortado não dispare o outro; a conversão em curso é esperada e descartada
+static void adc_capture_halt() {
+    adc_run(false);
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled(channel[i], false);
+        channel_config_set_chain_to(&config[i], channel[i]);
+        dma_channel_set_config(channel[i], &config[i], false);
+    }
+    for (int i = 0; i < 2; i++) {
+        dma_channel_abort(channel[i]);
+        dma_channel_acknowledge_irq0(channel[i]);
+    }
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) {
+        tight_loop_contents();
+    }
+    adc_fifo_drain();
+}
+
+// Arma os dois canais no início dos seus blocos e liga o ADC na primeira entrada do rodízio
+static void adc_capture_arm() {
+    next = 0;
+    phase = 0;
+    adc_select_input(order[0]);
+    for (int i = 0; i < 2; i++) {
+        channel_config_set_chain_to(&config[i], channel[i ^ 1]);
+        dma_channel_configure(channel[i], &config[i], blocks[i], &adc_hw->fifo, adc_capture_block_length, false);
+        dma_channel_set_irq0_enabled(channel[i], true);
+    }
+    dma_channel_start(channel[0]);
+    adc_run(true);
+}
+
+// Fim de um ou dos dois blocos: entrega na ordem em que foram preenchidos
+static void adc_capture_irq_handler() {
+    bool done[2] = { dma_channel_get_irq0_status(channel[0]), dma_channel_get_irq0_status(channel[1]) };
+    if (!done[0] && !done[1]) {
+        return;
+    }
+
+    // A entrada na interrupção serve de instante da última amostra do bloco
+    uint64_t now = time_us_64();
+
+    // Atraso: ao menos dois blocos terminaram desde a última entrega; os que couberam no
+    // intervalo estão todos perdidos
+    if (done[0] && done[1]) {
+        uint32_t lost = (uint32_t) ((now - last_block_us) * 1000 / adc_capture_block_ns());
+        overruns++;
+        lost_blocks += lost > 2 ? lost : 2;
+        adc_capture_halt();
+        adc_capture_arm();
+        last_block_us = time_us_64();
+        irq_us += last_block_us - now;
+        return;
+    }
+
+    while (dma_channel_get_irq0_status(channel[next])) {
+        dma_channel_acknowledge_irq0(channel[next]);
+        block_count++;
+        sample_count += adc_capture_block_length;
+        adc_capture_deliver(blocks[next], now);
+        next ^= 1;
+    }
+    last_block_us = now;
+    irq_us += time_us_64() - now;
+}
+
+// Inicia a aquisição contínua das entradas em 'input_mask' (bit n = entrada n), convertidas em
+// rodízio e trazidas por um único fluxo de DMA; cada uma recebe 1/n da taxa do ADC.
+// 'callback' (pode ser NULL) recebe as amostras de cada entrada, na interrupção DMA_IRQ_0.
+// Uma aquisição em curso é parada antes, para não prender mais canais nem registrar o tratador
+// de novo
+void adc_capture_start_round_robin(uint input_mask, adc_capture_callback_t callback) {
+    assert(input_mask && input_mask < (1u << adc_capture_inputs));
+
+    adc_capture_stop();
+
+    block_callback = callback;
+    block_count = overruns = lost_blocks = 0;
+    sample_count = irq_us = 0;
+    memset(rings, 0, sizeof(rings));
+
+    order_length = 0;
+    for (uint input = 0; input < adc_capture_inputs; input++) {
+        if (input_mask & (1u << input)) {
+            order[order_length++] = input;
+        }
+    }
+
+    // O rodízio começa pela entrada selecionada e segue em ordem crescente
+    adc_set_round_robin(order_length > 1 ? input_mask : 0);
+    adc_hw->div = clkdiv_q8; // o mesmo que adc_set_clkdiv(clkdiv_q8 / 256.0f), sem float
+    adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada amostra, 12 bits
+    adc_fifo_drain();
+
+    for (int i = 0; i < 2; i++) {
+        channel[i] = dma_claim_unused_channel(true);
+    }
+    for (int i = 0; i < 2; i++) {
+        config[i] = dma_channel_get_default_config(channel[i]);
+        channel_config_set_transfer_data_size(&config[i], DMA_SIZE_16);
+        channel_config_set_read_increment(&config[i], false);
+        channel_config_set_write_increment(&config[i], true);
+        channel_config_set_ring(&config[i], true, adc_capture_block_bits + 1); // anel de 2^12 bytes
+        channel_config_set_dreq(&config[i], DREQ_ADC);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, adc_capture_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    started_us = last_block_us = time_us_64();
+    adc_capture_arm();
+}
+
+// Inicia a aquisição contínua de uma só entrada
+void adc_capture_start(uint input, adc_capture_callback_t callback) {
+    adc_capture_start_round_robin(1u << input, callback);
+}
+
+// Para o ADC e libera os dois canais
+void adc_capture_stop() {
+    if (channel[0] < 0) {
+        return;
+    }
+
+    adc_capture_halt();
+    adc_set_round_robin(0);
+    for (int i = 0; i < 2; i++) {
+        dma_channel_unclaim(channel[i]);
+        channel[i] = -1;
+    }
+    irq_remove_handler(DMA_IRQ_0, adc_capture_irq_handler);
+
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+}
+
+// Com uma só entrada, a função de bloco recebe o próprio bloco do DMA, que continua valendo
+// depois dela até o canal que o escreve voltar a ele (quando o outro bloco termina). Retorna
+// true se o bloco que contém 'samples' ainda não começou a ser reescrito: o canal dele está
+// parado e sem fim de bloco por atender. Não vê um bloco já reescrito por inteiro e entregue de
+// novo: para isso, conte as entregas. Amostras de fora dos blocos (várias entradas) só valem
+// durante a chamada
+bool adc_capture_block_intact(const uint16_t *samples) {
+    for (int i = 0; i < 2; i++) {
+        if (samples >= blocks[i] && samples < blocks[i] + adc_capture_block_length) {
+            return channel[i] < 0 || (!dma_channel_is_busy(channel[i]) && !dma_channel_get_irq0_status(channel[i]));
+        }
+    }
+    return false;
+}
+
+// Contadores desde o início; taxa = samples * 1e6 / elapsed_us e carga da CPU = irq_us / elapsed_us.
+// Leia no núcleo que iniciou a aquisição (é nele que a interrupção roda)
+void adc_capture_get_stats(struct adc_capture_stats *out) {
+    uint32_t irq = save_and_disable_interrupts();
+    out->blocks = block_count;
+    out->samples = sample_count;
+    out->overruns = overruns;
+    out->lost = lost_blocks;
+    out->irq_us = irq_us;
+    restore_interrupts(irq);
+    out->elapsed_us = time_us_64() - started_us;
+}
+
+// Escolhe a taxa total do ADC, em amostras/s, somando todas as entradas do rodízio: de 500 mil
+// (conversões seguidas) até ~733 (o maior divisor). Vale a partir do próximo adc_capture_start.
+// Retorna a taxa obtida, arredondada (o divisor tem resolução de 1/256 de ciclo; com fração,
+// o intervalo entre amostras alterna entre os dois inteiros vizinhos)
+uint32_t adc_capture_set_rate(uint32_t rate) {
+    assert(rate > 0);
+
+    uint64_t period_q8 = ((uint64_t) 48000000 << 8) / rate;
+    if (period_q8 <= 96 << 8) {
+        clkdiv_q8 = 0;
+    }
+    else {
+        period_q8 -= 256;
+        clkdiv_q8 = period_q8 > 0xFFFFFF ? 0xFFFFFF : (uint32_t) period_q8; // 16 bits inteiros
+    }
+    return adc_capture_rate();
+}
+
+// Taxa total do ADC configurada, em amostras/s
+uint32_t adc_capture_rate() {
+    uint32_t period_q8 = adc_capture_period_q8();
+    return (uint32_t) ((((uint64_t) 48000000 << 8) + period_q8 / 2) / period_q8);
+}
+
+// Intervalo nominal entre duas amostras de uma mesma entrada, em ns (o período de conversão,
+// 2 us em 500 mil amostras/s, vezes o número de entradas do rodízio)
+uint32_t adc_capture_sample_period_ns() {
+    // período_q8 / 256 ciclos de 48 MHz = período_q8 * 125 / 1536 ns
+    return (uint32_t) ((uint64_t) adc_capture_period_q8() * 125 * order_length / 1536);
+}
+
+// Contadores de uma entrada; false se ela não está no rodízio
+bool adc_capture_channel_stats(uint input, struct adc_capture_channel_stats *out) {
+    struct adc_capture_ring *ring = &rings[input];
+    bool active = false;
+    for (uint i = 0; i < order_length; i++) {
+        active |= order[i] == input;
+    }
+    if (!active) {
+        return false;
+    }
+
+    uint32_t irq = save_and_disable_interrupts();
+    out->samples = ring->count;
+    out->last_us = ring->last_us;
+    out->latest = ring->count ? ring->samples[(ring->count - 1) & (adc_capture_ring_length - 1)] : 0;
+    restore_interrupts(irq);
+
+    uint64_t elapsed_us = time_us_64() - started_us;
+    out->rate = elapsed_us ? (uint32_t) (out->samples * 1000000 / elapsed_us) : 0;
+    return true;
+}
+
+// Copia as 'count' amostras mais recentes de uma entrada (no máximo um anel), da mais antiga para
+// a mais nova. A amostra k da cópia foi convertida por volta de
+//   *last_us - (n - 1 - k) * adc_capture_sample_period_ns() / 1000
+// Retorna quantas amostras foram copiadas
+uint adc_capture_channel_read(uint input, uint16_t *out, uint count, uint64_t *last_us) {
+    struct adc_capture_ring *ring = &rings[input];
+
+    uint32_t irq = save_and_disable_interrupts();
+    if (count > adc_capture_ring_length) count = adc_capture_ring_length;
+    if (count > ring->count) count = (uint) ring->count;
+
+    uint64_t first = ring->count - count;
+    for (uint i = 0; i < count; i++) {
+        out[i] = ring->samples[(first + i) & (adc_capture_ring_length - 1)];
+    }
+    if (last_us) {
+        *last_us = ring->last_us;
+    }
+    restore_interrupts(irq);
+    return count;
+}
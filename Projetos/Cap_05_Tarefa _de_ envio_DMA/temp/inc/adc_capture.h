@@ -0,0 +1,50 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_capture_inc_h
+#define adc_capture_inc_h
+
+// Aquisição contínua do ADC por dois canais de DMA encadeados (ping-pong): cada canal enche o
+// seu bloco e dispara o outro, então o ADC nunca para e nenhuma amostra fica sem destino
+#define adc_capture_block_bits 11                              // bloco de 2^11 amostras
+#define adc_capture_block_length (1u << adc_capture_block_bits) // 4,1 ms a 500 mil amostras/s (a taxa máxima)
+
+// Entradas do ADC: 0-3 são os GPIO 26-29, 4 é o sensor de temperatura interno
+#define adc_capture_inputs 5
+
+// Anel de amostras recentes de cada entrada, já separadas do fluxo em rodízio
+#define adc_capture_ring_bits 9
+#define adc_capture_ring_length (1u << adc_capture_ring_bits)
+
+// Chamada (em contexto de interrupção) a cada bloco completo, uma vez por entrada, com as
+// amostras dessa entrada. Os dados só valem durante a chamada
+typedef void (*adc_capture_callback_t)(uint input, const uint16_t *samples, uint count);
+
+struct adc_capture_stats {
+    uint32_t blocks;     // blocos entregues
+    uint64_t samples;    // amostras entregues
+    uint32_t overruns;   // interrupções atrasadas (os dois blocos prontos): a aquisição foi reiniciada
+    uint32_t lost;       // blocos perdidos nesses atrasos, estimados pelo tempo desde a última entrega
+    uint64_t elapsed_us; // tempo desde o início
+    uint64_t irq_us;     // tempo total na interrupção, incluindo a função do usuário
+};
+
+// Contadores de uma entrada
+struct adc_capture_channel_stats {
+    uint64_t samples;    // amostras recebidas
+    uint32_t rate;       // amostras/s medidas desde o início
+    uint64_t last_us;    // instante (time_us_64) da amostra mais recente
+    uint16_t latest;     // amostra mais recente
+};
+
+extern void adc_capture_start(uint input, adc_capture_callback_t callback);
+extern void adc_capture_start_round_robin(uint input_mask, adc_capture_callback_t callback);
+extern void adc_capture_stop();
+extern uint32_t adc_capture_set_rate(uint32_t rate);
+extern uint32_t adc_capture_rate();
+extern bool adc_capture_block_intact(const uint16_t *samples);
+extern void adc_capture_get_stats(struct adc_capture_stats *out);
+extern uint32_t adc_capture_sample_period_ns();
+extern bool adc_capture_channel_stats(uint input, struct adc_capture_channel_stats *out);
+extern uint adc_capture_channel_read(uint input, uint16_t *out, uint count, uint64_t *last_us);
+
+#endif
@@ -0,0 +1,66 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "adc_cic.h"
+
+// Os registradores crescem N * k bits acima dos 12 da entrada; com aritmética módulo 2^32, o
+// estouro dos integradores se cancela nos pentes desde que a saída caiba em 32 bits
+// (12 + N * k <= 32: R até 2^20 com N = 1, 2^10 com N = 2, 2^6 com N = 3, 2^5 com N = 4). Os quatro
+// integradores rodam sempre (a saída é tirada do estágio N), o que mantém o laço por amostra
+// em poucas instruções, sem desvios, e ele roda da RAM para não esperar pela flash
+
+// Decimador de ordem 'order' e razão 2^log2_ratio
+void adc_cic_init(adc_cic_t *cic, int order, int log2_ratio) {
+    assert(order >= 1 && order <= adc_cic_max_order && log2_ratio >= 0);
+    assert(12 + order * log2_ratio <= 32);
+
+    memset(cic, 0, sizeof(*cic));
+    cic->order = order;
+    cic->log2_ratio = log2_ratio;
+    cic->shift = order * log2_ratio - 4;
+}
+
+// Filtra 'count' amostras de 'in' e escreve as saídas prontas em 'out' (até count / R + 1).
+// O estado continua entre chamadas, então os blocos do DMA podem ser de qualquer tamanho.
+// Retorna o número de saídas
+uint __not_in_flash_func(adc_cic_process)(adc_cic_t *cic, const uint16_t *in, uint count, uint16_t *out) {
+    uint32_t i0 = cic->integrator[0], i1 = cic->integrator[1], i2 = cic->integrator[2], i3 = cic->integrator[3];
+    uint ratio = 1u << cic->log2_ratio;
+    uint phase = cic->phase;
+    uint produced = 0;
+
+    while (count) {
+        // Integra até a próxima saída (ou o fim do bloco), sem teste por amostra
+        uint run = ratio - phase;
+        if (run > count) {
+            run = count;
+        }
+        for (const uint16_t *end = in + run; in < end; in++) {
+            i0 += *in;
+            i1 += i0;
+            i2 += i1;
+            i3 += i2;
+        }
+        count -= run;
+        phase += run;
+        if (phase < ratio) {
+            break;
+        }
+        phase = 0;
+
+        // Pentes na taxa de saída
+        uint32_t value = cic->order == 1 ? i0 : cic->order == 2 ? i1 : cic->order == 3 ? i2 : i3;
+        for (int stage = 0; stage < cic->order; stage++) {
+            uint32_t input = value;
+            value -= cic->comb[stage];
+            cic->comb[stage] = input;
+        }
+        out[produced++] = (uint16_t) (cic->shift >= 0 ? value >> cic->shift : value << -cic->shift);
+    }
+
+    cic->integrator[0] = i0;
+    cic->integrator[1] = i1;
+    cic->integrator[2] = i2;
+    cic->integrator[3] = i3;
+    cic->phase = phase;
+    return produced;
+}
@@ -0,0 +1,24 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_cic_inc_h
+#define adc_cic_inc_h
+
+// Decimador CIC (cascaded integrator-comb) para amostras de 12 bits: N integradores na taxa de
+// entrada, redução por R = 2^k e N pentes (atraso diferencial 1) na taxa de saída. A soma de R
+// amostras rende bits a mais de resolução efetiva (k/2 bits com ruído branco na entrada); a saída
+// é de 16 bits, o código de 12 bits seguido de 4 bits de fração
+#define adc_cic_max_order 4
+
+typedef struct {
+    uint8_t order;       // N, de 1 a adc_cic_max_order
+    uint8_t log2_ratio;  // k (R = 2^k)
+    int8_t shift;        // deslocamento à direita que leva o ganho R^N para a saída de 16 bits
+    uint32_t phase;      // amostras de entrada desde a última saída (R chega a 2^20 com N = 1)
+    uint32_t integrator[adc_cic_max_order];
+    uint32_t comb[adc_cic_max_order]; // entrada anterior de cada pente
+} adc_cic_t;
+
+extern void adc_cic_init(adc_cic_t *cic, int order, int log2_ratio);
+extern uint adc_cic_process(adc_cic_t *cic, const uint16_t *in, uint count, uint16_t *out);
+
+#endif
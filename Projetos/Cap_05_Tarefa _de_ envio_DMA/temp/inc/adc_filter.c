@@ -0,0 +1,186 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "adc_filter.h"
+
+// Todos os filtros começam sem transitório: a média e a mediana usam só as amostras já
+// recebidas, e o IIR e o FIR partem do valor da primeira amostra (o ADC tem nível DC, e partir
+// de zero faria a saída subir devagar do zero). As entradas de bloco rodam da RAM
+
+// Média móvel
+
+void adc_filter_average_init(adc_filter_average_t *filter, int length) {
+    assert(length > 0 && length <= adc_filter_average_max);
+
+    memset(filter, 0, sizeof(*filter));
+    filter->length = length;
+}
+
+// Acrescenta uma amostra e retorna a média arredondada da janela
+static inline uint16_t adc_filter_average_step(adc_filter_average_t *filter, uint16_t sample) {
+    uint index = filter->index;
+
+    if (filter->count < filter->length) {
+        index = filter->count++;
+    }
+    else {
+        filter->sum -= filter->history[index];
+        filter->index = index + 1 == filter->length ? 0 : index + 1;
+    }
+    filter->history[index] = sample;
+    filter->sum += sample;
+    return (uint16_t) ((filter->sum + filter->count / 2) / filter->count);
+}
+
+uint16_t adc_filter_average_push(adc_filter_average_t *filter, uint16_t sample) {
+    return adc_filter_average_step(filter, sample);
+}
+
+void __not_in_flash_func(adc_filter_average_process)(adc_filter_average_t *filter, const uint16_t *in, uint count, uint16_t *out) {
+    for (uint i = 0; i < count; i++) {
+        out[i] = adc_filter_average_step(filter, in[i]);
+    }
+}
+
+// Mediana
+
+void adc_filter_median_init(adc_filter_median_t *filter, int length) {
+    assert(length > 0 && length <= adc_filter_median_max);
+
+    memset(filter, 0, sizeof(*filter));
+    filter->length = length;
+}
+
+// Primeira posição de 'sorted' com valor >= 'value' (busca binária)
+static inline uint adc_filter_lower_bound(const uint16_t *sorted, uint count, uint16_t value) {
+    uint low = 0, high = count;
+    while (low < high) {
+        uint middle = (low + high) / 2;
+        if (sorted[middle] < value) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Com a janela cheia, a amostra nova toma a vaga da mais antiga no vetor ordenado e escorrega
+// até a sua posição: o custo é a distância entre os dois valores na ordem, pequena num sinal
+// que varia devagar
+static inline uint16_t adc_filter_median_step(adc_filter_median_t *filter, uint16_t sample) {
+    uint16_t *sorted = filter->sorted;
+    uint position;
+
+    if (filter->count < filter->length) {
+        position = filter->count++;
+    }
+    else {
+        position = adc_filter_lower_bound(sorted, filter->count, filter->history[filter->index]);
+    }
+    filter->history[filter->index] = sample;
+    filter->index = filter->index + 1 == filter->length ? 0 : filter->index + 1;
+
+    while (position + 1 < filter->count && sorted[position + 1] < sample) {
+        sorted[position] = sorted[position + 1];
+        position++;
+    }
+    while (position > 0 && sorted[position - 1] > sample) {
+        sorted[position] = sorted[position - 1];
+        position--;
+    }
+    sorted[position] = sample;
+    return sorted[filter->count / 2];
+}
+
+uint16_t adc_filter_median_push(adc_filter_median_t *filter, uint16_t sample) {
+    return adc_filter_median_step(filter, sample);
+}
+
+void __not_in_flash_func(adc_filter_median_process)(adc_filter_median_t *filter, const uint16_t *in, uint count, uint16_t *out) {
+    for (uint i = 0; i < count; i++) {
+        out[i] = adc_filter_median_step(filter, in[i]);
+    }
+}
+
+// IIR de primeira ordem
+
+// 'shift' de 1 a 15. O estado é de 64 bits: com amostras de 16 bits (blocos já acumulados pelo
+// CIC, por exemplo) a entrada em Q16 não cabe em int32
+void adc_filter_iir_init(adc_filter_iir_t *filter, int shift) {
+    assert(shift > 0 && shift < 16);
+
+    filter->state = 0;
+    filter->shift = shift;
+    filter->primed = false;
+}
+
+static inline uint16_t adc_filter_iir_step(adc_filter_iir_t *filter, uint16_t sample) {
+    int64_t input = (int64_t) sample << 16;
+
+    if (!filter->primed) {
+        filter->state = input;
+        filter->primed = true;
+    }
+    filter->state += (input - filter->state) >> filter->shift;
+    return (uint16_t) ((filter->state + 0x8000) >> 16);
+}
+
+uint16_t adc_filter_iir_push(adc_filter_iir_t *filter, uint16_t sample) {
+    return adc_filter_iir_step(filter, sample);
+}
+
+void __not_in_flash_func(adc_filter_iir_process)(adc_filter_iir_t *filter, const uint16_t *in, uint count, uint16_t *out) {
+    for (uint i = 0; i < count; i++) {
+        out[i] = adc_filter_iir_step(filter, in[i]);
+    }
+}
+
+// FIR
+
+// Copia 'taps' coeficientes Q15 (o primeiro multiplica a amostra mais recente)
+void adc_filter_fir_init(adc_filter_fir_t *filter, const int16_t *coeffs, int taps) {
+    assert(taps > 0 && taps <= adc_filter_fir_max);
+
+    memset(filter, 0, sizeof(*filter));
+    for (int k = 0; k < taps; k++) {
+        filter->coeffs[k] = coeffs[k];
+    }
+    filter->taps = taps;
+}
+
+static inline uint16_t adc_filter_fir_step(adc_filter_fir_t *filter, uint16_t sample) {
+    uint taps = filter->taps;
+
+    if (!filter->primed) {
+        for (uint k = 0; k < 2 * taps; k++) {
+            filter->history[k] = sample;
+        }
+        filter->primed = true;
+    }
+
+    // A amostra nova entra antes da anterior e nas duas cópias: history[index + k] é x[n - k]
+    uint index = (filter->index == 0 ? taps : filter->index) - 1;
+    filter->index = index;
+    filter->history[index] = filter->history[index + taps] = sample;
+
+    const uint16_t *x = filter->history + index;
+    // Cada produto cabe em int32 (|coef| <= 32768, amostra < 65536), mas a soma de amostras de
+    // 16 bits não: com ganho acima de 1,0 ela passa de INT32_MAX
+    int64_t acc = 1 << 14; // arredondamento
+    for (uint k = 0; k < taps; k++) {
+        acc += filter->coeffs[k] * (int32_t) x[k];
+    }
+    acc >>= 15;
+    return acc < 0 ? 0 : acc > UINT16_MAX ? UINT16_MAX : (uint16_t) acc;
+}
+
+uint16_t adc_filter_fir_push(adc_filter_fir_t *filter, uint16_t sample) {
+    return adc_filter_fir_step(filter, sample);
+}
+
+void __not_in_flash_func(adc_filter_fir_process)(adc_filter_fir_t *filter, const uint16_t *in, uint count, uint16_t *out) {
+    for (uint i = 0; i < count; i++) {
+        out[i] = adc_filter_fir_step(filter, in[i]);
+    }
+}
@@ -0,0 +1,65 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_filter_inc_h
+#define adc_filter_inc_h
+
+// Filtros em ponto fixo para fluxos de amostras do ADC (uint16_t, sem float). Cada filtro tem
+// a entrada de uma amostra (push) e a de bloco (process), que aceita direto o bloco entregue
+// pela aquisição por DMA; 'out' pode ser o próprio 'in'. As saídas estão na unidade da entrada
+#define adc_filter_average_max 64 // janela máxima da média móvel
+#define adc_filter_median_max 31  // janela máxima da mediana
+#define adc_filter_fir_max 32     // número máximo de coeficientes do FIR
+
+// Média móvel das últimas 'length' amostras (soma corrente: custo fixo por amostra)
+typedef struct {
+    uint16_t history[adc_filter_average_max];
+    uint32_t sum;
+    uint16_t length;
+    uint16_t index; // posição da amostra mais antiga
+    uint16_t count; // amostras na janela (menos que 'length' só no início)
+} adc_filter_average_t;
+
+// Mediana das últimas 'length' amostras: remove picos isolados sem borrar degraus
+typedef struct {
+    uint16_t history[adc_filter_median_max];
+    uint16_t sorted[adc_filter_median_max]; // a mesma janela em ordem crescente
+    uint16_t length;
+    uint16_t index;
+    uint16_t count;
+} adc_filter_median_t;
+
+// IIR de primeira ordem (suavização exponencial): y += (x - y) / 2^shift, com o estado em Q16
+// (64 bits, para amostras de até 16 bits). Frequência de corte ~ taxa / (2 * pi * 2^shift)
+typedef struct {
+    int64_t state;
+    uint8_t shift;
+    bool primed;
+} adc_filter_iir_t;
+
+// FIR com coeficientes em Q15 (32768 = 1,0). O histórico é guardado duas vezes seguidas, para
+// que o produto escalar percorra um vetor contínuo, sem teste de fim de anel
+typedef struct {
+    int16_t coeffs[adc_filter_fir_max];
+    uint16_t history[2 * adc_filter_fir_max];
+    uint16_t taps;
+    uint16_t index; // posição da amostra mais recente
+    bool primed;
+} adc_filter_fir_t;
+
+extern void adc_filter_average_init(adc_filter_average_t *filter, int length);
+extern uint16_t adc_filter_average_push(adc_filter_average_t *filter, uint16_t sample);
+extern void adc_filter_average_process(adc_filter_average_t *filter, const uint16_t *in, uint count, uint16_t *out);
+
+extern void adc_filter_median_init(adc_filter_median_t *filter, int length);
+extern uint16_t adc_filter_median_push(adc_filter_median_t *filter, uint16_t sample);
+extern void adc_filter_median_process(adc_filter_median_t *filter, const uint16_t *in, uint count, uint16_t *out);
+
+extern void adc_filter_iir_init(adc_filter_iir_t *filter, int shift);
+extern uint16_t adc_filter_iir_push(adc_filter_iir_t *filter, uint16_t sample);
+extern void adc_filter_iir_process(adc_filter_iir_t *filter, const uint16_t *in, uint count, uint16_t *out);
+
+extern void adc_filter_fir_init(adc_filter_fir_t *filter, const int16_t *coeffs, int taps);
+extern uint16_t adc_filter_fir_push(adc_filter_fir_t *filter, uint16_t sample);
+extern void adc_filter_fir_process(adc_filter_fir_t *filter, const uint16_t *in, uint count, uint16_t *out);
+
+#endif
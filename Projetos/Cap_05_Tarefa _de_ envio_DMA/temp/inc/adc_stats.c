@@ -0,0 +1,167 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "adc_stats.h"
+
+// Janela deslizante em O(1) por amostra. A amostra que sai da janela é a que está na vaga do
+// anel onde a nova vai entrar:
+// - soma e soma dos quadrados: com amostras inteiras elas são exatas (mesmo com 1024 amostras
+//   de 16 bits, a soma cabe em 32 bits e a dos quadrados em 64), então somar a nova e subtrair a que sai não
+//   acumula erro; a variância sai delas na leitura, n * S2 - S1^2, também exata;
+// - mínimo e máximo: filas monótonas de posições. A nova amostra descarta do fim da fila as
+//   que nunca mais podem ser o mínimo (maiores ou iguais a ela) e entra no fim; a frente é o
+//   mínimo e sai quando a sua vaga é reaproveitada (custo amortizado O(1));
+// - histograma: +1 na faixa da nova, -1 na faixa da que sai.
+// Ao fim de cada bloco, o escritor publica um resumo sob um contador de sequência (ímpar durante
+// a cópia); o leitor copia o resumo e tenta de novo se o contador mudou, então nenhum dos lados
+// espera pelo outro e a aquisição não para
+
+// 'window_bits' até adc_stats_window_bits_max. O histograma cobre adc_stats_bins faixas de
+// 2^histogram_shift códigos a partir de 'histogram_low'
+void adc_stats_init(adc_stats_t *stats, int window_bits, uint16_t histogram_low, int histogram_shift) {
+    assert(window_bits >= 0 && window_bits <= adc_stats_window_bits_max);
+    assert(histogram_shift >= 0 && histogram_shift < 16);
+
+    memset(stats, 0, sizeof(*stats));
+    stats->mask = (1u << window_bits) - 1;
+    stats->histogram_low = histogram_low;
+    stats->histogram_shift = histogram_shift;
+}
+
+// Faixa do histograma de um código
+static inline uint adc_stats_bin(const adc_stats_t *stats, uint16_t sample) {
+    if (sample < stats->histogram_low) {
+        return 0;
+    }
+    uint bin = (uint) (sample - stats->histogram_low) >> stats->histogram_shift;
+    return bin < adc_stats_bins ? bin : adc_stats_bins - 1;
+}
+
+static inline void adc_stats_push(adc_stats_t *stats, uint16_t sample) {
+    uint mask = stats->mask;
+    uint slot = stats->position & mask;
+
+    // Com a janela cheia, retira a amostra que ocupa a vaga
+    if (stats->count > mask) {
+        uint16_t old = stats->history[slot];
+        stats->sum -= old;
+        stats->sum_squares -= (uint32_t) old * old;
+        stats->histogram[adc_stats_bin(stats, old)]--;
+        if (stats->min_queue[stats->min_head] == slot) {
+            stats->min_head = (stats->min_head + 1) & mask;
+            stats->min_length--;
+        }
+        if (stats->max_queue[stats->max_head] == slot) {
+            stats->max_head = (stats->max_head + 1) & mask;
+            stats->max_length--;
+        }
+    }
+    else {
+        stats->count++;
+    }
+
+    stats->history[slot] = sample;
+    stats->sum += sample;
+    stats->sum_squares += (uint32_t) sample * sample;
+    stats->histogram[adc_stats_bin(stats, sample)]++;
+
+    while (stats->min_length && stats->history[stats->min_queue[(stats->min_head + stats->min_length - 1) & mask]] >= sample) {
+        stats->min_length--;
+    }
+    stats->min_queue[(stats->min_head + stats->min_length++) & mask] = slot;
+
+    while (stats->max_length && stats->history[stats->max_queue[(stats->max_head + stats->max_length - 1) & mask]] <= sample) {
+        stats->max_length--;
+    }
+    stats->max_queue[(stats->max_head + stats->max_length++) & mask] = slot;
+
+    stats->position++;
+}
+
+// Acrescenta um bloco de amostras e publica o resumo. Chame sempre do mesmo contexto (por
+// exemplo, a função de bloco de adc_capture, na interrupção do DMA)
+void __not_in_flash_func(adc_stats_push_block)(adc_stats_t *stats, const uint16_t *samples, uint count) {
+    if (count == 0) {
+        return;
+    }
+
+    for (uint i = 0; i < count; i++) {
+        adc_stats_push(stats, samples[i]);
+    }
+    stats->total += count;
+
+    struct adc_stats_published *published = &stats->published;
+    stats->sequence++;
+    __dmb();
+    published->count = stats->count;
+    published->total = stats->total;
+    published->min = stats->history[stats->min_queue[stats->min_head]];
+    published->max = stats->history[stats->max_queue[stats->max_head]];
+    published->sum = stats->sum;
+    published->sum_squares = stats->sum_squares;
+    memcpy(published->histogram, stats->histogram, sizeof(published->histogram));
+    __dmb();
+    stats->sequence++;
+}
+
+// Raiz quadrada inteira (parte inteira)
+static uint32_t adc_stats_isqrt(uint64_t value) {
+    uint64_t root = 0, bit = 1ull << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t) root;
+}
+
+// Copia o resumo publicado mais recente e calcula média, variância e desvio padrão. Pode ser
+// chamada de qualquer núcleo, a qualquer momento; não deve interromper o escritor (não chame
+// de uma interrupção de prioridade maior que a dele)
+void adc_stats_read(adc_stats_t *stats, struct adc_stats_summary *out) {
+    struct adc_stats_published copy;
+    uint32_t sequence;
+
+    do {
+        do {
+            sequence = stats->sequence;
+        } while (sequence & 1);
+        __dmb();
+        copy = stats->published;
+        __dmb();
+    } while (stats->sequence != sequence);
+
+    memset(out, 0, sizeof(*out));
+    out->count = copy.count;
+    out->total = copy.total;
+    out->histogram_low = stats->histogram_low;
+    out->histogram_shift = stats->histogram_shift;
+    memcpy(out->histogram, copy.histogram, sizeof(out->histogram));
+    if (copy.count == 0) {
+        return;
+    }
+
+    uint64_t n = copy.count;
+    out->min = copy.min;
+    out->max = copy.max;
+    out->sum = copy.sum;
+    out->sum_squares = copy.sum_squares;
+    out->mean_q8 = (uint32_t) ((((uint64_t) copy.sum << 8) + n / 2) / n);
+
+    // n^2 * variância = n * S2 - S1^2; a divisão por n^2 é feita em duas partes para que o
+    // deslocamento para Q16 não estoure com amostras de 16 bits
+    uint64_t scaled = n * copy.sum_squares - (uint64_t) copy.sum * copy.sum;
+    uint64_t quotient = scaled / (n * n), remainder = scaled % (n * n);
+    uint64_t variance_q16 = (quotient << 16) + (remainder << 16) / (n * n);
+    out->variance_q8 = variance_q16 >> 8;
+    out->stddev_q8 = adc_stats_isqrt(variance_q16);
+}
@@ -0,0 +1,63 @@
+#include "pico/stdlib.h"
+
+#ifndef adc_stats_inc_h
+#define adc_stats_inc_h
+
+// Estatísticas de uma janela deslizante das últimas 2^bits amostras (mínimo, máximo, média,
+// variância e histograma), atualizadas em O(1) por amostra a cada bloco da aquisição, sem
+// reler a janela. O resumo publicado após cada bloco pode ser lido de qualquer núcleo
+#define adc_stats_window_bits_max 10 // janela de até 1024 amostras
+#define adc_stats_window_max (1u << adc_stats_window_bits_max)
+#define adc_stats_bins 16
+
+// Resumo da janela. Média, variância e desvio padrão em Q8 (256 = 1 código)
+struct adc_stats_summary {
+    uint32_t count;       // amostras na janela
+    uint64_t total;       // amostras recebidas desde o início
+    uint16_t min, max;
+    uint32_t sum;         // para adc_temp_centi(sum, count)
+    uint64_t sum_squares;
+    uint32_t mean_q8;
+    uint64_t variance_q8;
+    uint32_t stddev_q8;
+    uint16_t histogram_low;   // primeiro código da faixa 0
+    uint8_t histogram_shift;  // cada faixa tem 2^shift códigos (as pontas incluem o que sobra)
+    uint16_t histogram[adc_stats_bins];
+};
+
+// Parte publicada, copiada pelos leitores sob o contador de sequência
+struct adc_stats_published {
+    uint32_t count;
+    uint64_t total;
+    uint16_t min, max;
+    uint32_t sum;
+    uint64_t sum_squares;
+    uint16_t histogram[adc_stats_bins];
+};
+
+typedef struct {
+    // Estado do escritor (só o contexto que chama adc_stats_push_block)
+    uint16_t history[adc_stats_window_max];  // anel de amostras, indexado pela posição
+    uint16_t min_queue[adc_stats_window_max]; // posições com valores crescentes (a frente é o mínimo)
+    uint16_t max_queue[adc_stats_window_max]; // posições com valores decrescentes (a frente é o máximo)
+    uint16_t min_head, min_length, max_head, max_length;
+    uint16_t mask;
+    uint16_t histogram_low;
+    uint8_t histogram_shift;
+    uint32_t position; // amostras recebidas (a próxima vai para history[position & mask])
+    uint32_t count;
+    uint32_t sum;
+    uint64_t sum_squares;
+    uint64_t total;
+    uint16_t histogram[adc_stats_bins];
+
+    // Resumo do último bloco: 'sequence' é ímpar enquanto ele está sendo reescrito
+    volatile uint32_t sequence;
+    struct adc_stats_published published;
+} adc_stats_t;
+
+extern void adc_stats_init(adc_stats_t *stats, int window_bits, uint16_t histogram_low, int histogram_shift);
+extern void adc_stats_push_block(adc_stats_t *stats, const uint16_t *samples, uint count);
+extern void adc_stats_read(adc_stats_t *stats, struct adc_stats_summary *out);
+
+#endif
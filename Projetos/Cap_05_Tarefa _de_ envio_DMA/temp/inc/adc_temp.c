@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "adc_temp.h"
+
+// Conversão e formatação da temperatura sem ponto flutuante: o Cortex-M0+ não tem FPU, então
+// cada operação em float é uma rotina de software de dezenas de ciclos. A média de uma janela
+// vira temperatura com uma única divisão de 64 bits, e o erro em relação à fórmula em float do
+// datasheet fica dentro do arredondamento (±0,51 centésimo)
+
+// Divisão arredondada para o inteiro mais próximo, para numeradores de qualquer sinal
+static int64_t adc_temp_div_round(int64_t num, int64_t den) {
+    return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+}
+
+// Temperatura média de uma janela: 'code_sum' é a soma de 'count' códigos de 12 bits. Como a
+// conversão é linear, converter a média dos códigos dá o mesmo que a média das temperaturas
+int32_t adc_temp_centi(uint64_t code_sum, uint32_t count) {
+    int64_t num = adc_temp_offset_q16 * count - adc_temp_slope_q16 * (int64_t) code_sum;
+    return (int32_t) adc_temp_div_round(num, (int64_t) count << 16);
+}
+
+// Temperatura de uma única amostra
+int32_t adc_temp_centi_from_code(uint16_t code) {
+    return (int32_t) adc_temp_div_round(adc_temp_offset_q16 - adc_temp_slope_q16 * code, 1 << 16);
+}
+
+// Escreve 'centi' (centésimos de grau) com 0 a 2 casas decimais, arredondando ("25.31", "25.3",
+// "-0.5"), sem o %f do printf. Retorna o comprimento, como snprintf
+int adc_temp_format(char *out, size_t size, int32_t centi, int decimals) {
+    static const int32_t scale[] = { 100, 10, 1 };
+    assert(decimals >= 0 && decimals <= 2);
+
+    int32_t value = (int32_t) adc_temp_div_round(centi, scale[decimals]);
+    uint32_t magnitude = value < 0 ? -(uint32_t) value : (uint32_t) value;
+    const char *sign = value < 0 ? "-" : "";
+
+    if (decimals == 0) {
+        return snprintf(out, size, "%s%lu", sign, (unsigned long) magnitude);
+    }
+    uint32_t unit = decimals == 1 ? 10 : 100;
+    return snprintf(out, size, "%s%lu.%0*lu", sign, (unsigned long) (magnitude / unit), decimals, (unsigned long) (magnitude % unit));
+}
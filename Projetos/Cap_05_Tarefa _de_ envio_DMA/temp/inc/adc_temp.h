@@ -0,0 +1,17 @@
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+#ifndef adc_temp_inc_h
+#define adc_temp_inc_h
+
+// Sensor de temperatura interno em centésimos de grau, só com inteiros. Pelo datasheet do RP2040,
+//   T = 27 - (V - 0,706) / 0,001721, com V = código * 3,3 / 4096
+// o que dá T = 43722,66 - 46,8137 * código (em centésimos), com as constantes em Q16
+#define adc_temp_offset_q16 2865408327ll // 43722,66 * 65536
+#define adc_temp_slope_q16 3067984ll     // 46,8137 * 65536 (centésimos por código)
+
+extern int32_t adc_temp_centi(uint64_t code_sum, uint32_t count);
+extern int32_t adc_temp_centi_from_code(uint16_t code);
+extern int adc_temp_format(char *out, size_t size, int32_t centi, int decimals);
+
+#endif
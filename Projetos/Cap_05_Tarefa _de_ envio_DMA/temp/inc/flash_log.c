@@ -0,0 +1,263 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "flash_log.h"
+
+// Os registros ficam num setor em RAM até ele encher; só então o setor seguinte da região é
+// apagado e gravado, com cabeçalho (sequência, contagem, CRC). Gravar sempre setores inteiros,
+// em rodízio, mantém a amplificação de escrita perto de 1 e o desgaste igual em todos eles.
+// A flash não pode ser lida (nem executada) durante um apagamento ou gravação, então cada
+// operação passa por flash_safe_execute: as interrupções deste núcleo ficam desligadas e o
+// outro núcleo espera num laço em RAM (ele precisa ter chamado multicore_lockout_victim_init).
+// Para não segurar o outro núcleo mais que o necessário, o cabeçalho e o CRC são montados antes,
+// e o apagamento e cada página de 256 bytes são operações separadas: a pausa mais longa é a de
+// um apagamento (~45 ms), e só as páginas usadas são gravadas. Durante essa pausa a interrupção
+// do DMA do ADC também espera, então blocos da aquisição podem se perder (contados em overruns)
+//
+// Na partida, o setor mais novo é achado por busca binária: na ordem da região, os setores
+// válidos da volta atual têm sequência >= à do setor 0 e formam um prefixo; os seguintes são
+// da volta anterior, apagados ou inválidos (uma gravação interrompida)
+
+// Prazo para conseguir a exclusividade da flash
+#define flash_log_timeout_ms 100
+
+// Fim do programa na flash (do linker script do SDK): a região não pode começar antes dele
+extern char __flash_binary_end;
+
+// CRC-32 (polinômio 0xEDB88320) meio byte por vez, com uma tabela de 16 entradas
+static uint32_t flash_log_crc(uint32_t crc, const uint8_t *data, size_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+// CRC de um setor: o cabeçalho com o campo crc zerado, seguido dos registros
+static uint32_t flash_log_sector_crc(const struct flash_log_header *header, const uint8_t *records, size_t length) {
+    struct flash_log_header copy = *header;
+    copy.crc = 0;
+
+    uint32_t crc = flash_log_crc(0xFFFFFFFF, (const uint8_t *) &copy, sizeof(copy));
+    return ~flash_log_crc(crc, records, length);
+}
+
+// Setor 'index' da região, lido pelo XIP
+static inline const struct flash_log_header *flash_log_sector(const flash_log_t *log, uint index) {
+    return (const struct flash_log_header *) (XIP_BASE + log->offset + index * FLASH_SECTOR_SIZE);
+}
+
+// Setor com cabeçalho deste registro e CRC correto
+static bool flash_log_valid(const flash_log_t *log, uint index) {
+    const struct flash_log_header *header = flash_log_sector(log, index);
+
+    if (header->magic != flash_log_magic || header->record_size != log->record_size || header->count == 0 || header->count > log->capacity) {
+        return false;
+    }
+    return flash_log_sector_crc(header, (const uint8_t *) (header + 1), header->count * log->record_size) == header->crc;
+}
+
+// Abre o registro na região de 'sectors' setores a partir de 'offset' (múltiplo de 4 KiB, depois
+// do programa). Retorna true se encontrou registros gravados antes
+bool flash_log_init(flash_log_t *log, uint32_t offset, uint sectors, uint record_size) {
+    assert(offset % FLASH_SECTOR_SIZE == 0 && sectors > 0 && sectors <= UINT16_MAX);
+    assert(offset + sectors * FLASH_SECTOR_SIZE <= PICO_FLASH_SIZE_BYTES);
+    assert(XIP_BASE + offset >= (uintptr_t) &__flash_binary_end);
+    assert(record_size > 0 && record_size <= flash_log_payload_size);
+
+    memset(log, 0, sizeof(*log));
+    log->offset = offset;
+    log->sectors = sectors;
+    log->record_size = record_size;
+    log->capacity = flash_log_payload_size / record_size;
+
+    int newest = -1;
+    if (flash_log_valid(log, 0)) {
+        // Último setor do prefixo com sequência >= à do setor 0
+        uint32_t first = flash_log_sector(log, 0)->sequence;
+        uint low = 0, high = sectors - 1;
+        while (low < high) {
+            uint middle = (low + high + 1) / 2;
+            if (flash_log_valid(log, middle) && (int32_t) (flash_log_sector(log, middle)->sequence - first) >= 0) {
+                low = middle;
+            }
+            else {
+                high = middle - 1;
+            }
+        }
+        newest = low;
+    }
+    else if (sectors > 1 && flash_log_valid(log, sectors - 1)) {
+        // A gravação do setor 0 foi interrompida na volta: o mais novo é o último
+        newest = sectors - 1;
+    }
+
+    if (newest < 0) {
+        return false;
+    }
+
+    uint32_t sequence = flash_log_sector(log, newest)->sequence;
+    log->head = (newest + 1) % sectors;
+    log->sequence = sequence + 1;
+    log->stored = sequence + 1 < sectors ? sequence + 1 : sectors;
+    return true;
+}
+
+// Operações na flash, executadas por flash_safe_execute
+struct flash_log_operation {
+    uint32_t offset;
+    const uint8_t *data;
+};
+
+static void flash_log_erase_sector(void *param) {
+    const struct flash_log_operation *operation = param;
+    flash_range_erase(operation->offset, FLASH_SECTOR_SIZE);
+}
+
+static void flash_log_program_page(void *param) {
+    const struct flash_log_operation *operation = param;
+    flash_range_program(operation->offset, operation->data, FLASH_PAGE_SIZE);
+}
+
+// Executa uma operação com a flash só para este núcleo; devolve a duração em *elapsed_us
+static bool flash_log_execute(flash_log_t *log, void (*function)(void *), struct flash_log_operation *operation, uint32_t *elapsed_us) {
+    uint64_t start = time_us_64();
+    int result = flash_safe_execute(function, operation, flash_log_timeout_ms);
+    uint32_t elapsed = (uint32_t) (time_us_64() - start);
+
+    if (elapsed > log->stats.longest_lockout_us) {
+        log->stats.longest_lockout_us = elapsed;
+    }
+    *elapsed_us += elapsed;
+    if (result != PICO_OK) {
+        log->stats.failures++;
+        return false;
+    }
+    return true;
+}
+
+// Grava o setor em RAM, mesmo incompleto (por exemplo, antes de desligar); os registros
+// seguintes vão para o próximo setor. Retorna false se a flash não pôde ser gravada (os
+// registros continuam em RAM)
+bool flash_log_commit(flash_log_t *log) {
+    if (log->pending == 0) {
+        return true;
+    }
+
+    uint64_t start = time_us_64();
+    size_t used = sizeof(struct flash_log_header) + log->pending * log->record_size;
+    struct flash_log_header *header = (struct flash_log_header *) log->sector;
+    header->magic = flash_log_magic;
+    header->sequence = log->sequence;
+    header->record_size = log->record_size;
+    header->count = log->pending;
+    header->crc = flash_log_sector_crc(header, log->sector + sizeof(*header), used - sizeof(*header));
+    memset(log->sector + used, 0xFF, FLASH_SECTOR_SIZE - used); // o resto da última página fica como apagado
+
+    struct flash_log_operation operation = { log->offset + log->head * FLASH_SECTOR_SIZE, NULL };
+    uint32_t erase_us = 0, program_us = 0;
+    if (!flash_log_execute(log, flash_log_erase_sector, &operation, &erase_us)) {
+        return false;
+    }
+    for (size_t page = 0; page < used; page += FLASH_PAGE_SIZE) {
+        struct flash_log_operation program = { operation.offset + page, log->sector + page };
+        if (!flash_log_execute(log, flash_log_program_page, &program, &program_us)) {
+            return false;
+        }
+    }
+
+    struct flash_log_stats *stats = &log->stats;
+    stats->commits++;
+    stats->payload_bytes += log->pending * log->record_size;
+    stats->flash_bytes += FLASH_SECTOR_SIZE;
+    stats->erase_us = erase_us;
+    stats->program_us = program_us;
+    stats->last_commit_us = (uint32_t) (time_us_64() - start);
+    if (stats->last_commit_us > stats->max_commit_us) {
+        stats->max_commit_us = stats->last_commit_us;
+    }
+
+    log->head = (log->head + 1) % log->sectors;
+    log->sequence++;
+    if (log->stored < log->sectors) {
+        log->stored++;
+    }
+    log->pending = 0;
+    return true;
+}
+
+// Acrescenta um registro de 'record_size' bytes; com o setor em RAM cheio, grava-o na flash.
+// Retorna flash_log_committed se um setor foi gravado nesta chamada, flash_log_buffered se o
+// registro só entrou em RAM e flash_log_rejected se a gravação pendente falhou (o registro
+// não entrou)
+flash_log_result_t flash_log_append(flash_log_t *log, const void *record) {
+    flash_log_result_t result = flash_log_buffered;
+
+    if (log->pending == log->capacity) {
+        if (!flash_log_commit(log)) {
+            return flash_log_rejected;
+        }
+        result = flash_log_committed;
+    }
+
+    memcpy(log->sector + sizeof(struct flash_log_header) + log->pending * log->record_size, record, log->record_size);
+    log->pending++;
+    log->stats.records++;
+    if (log->pending == log->capacity && flash_log_commit(log)) {
+        result = flash_log_committed;
+    }
+    return result;
+}
+
+// Setor gravado 'back' posições antes do mais novo (0 = o mais novo), ou NULL se ele não é da
+// sequência esperada (ainda não gravado, ou perdido numa gravação interrompida)
+static const struct flash_log_header *flash_log_stored_sector(const flash_log_t *log, uint32_t back) {
+    if (back >= log->stored) {
+        return NULL;
+    }
+    uint index = (log->head + log->sectors - 1 - back) % log->sectors;
+    const struct flash_log_header *header = flash_log_sector(log, index);
+    return header->magic == flash_log_magic && header->sequence == log->sequence - 1 - back ? header : NULL;
+}
+
+// Registros disponíveis (na flash e ainda em RAM)
+uint32_t flash_log_count(const flash_log_t *log) {
+    uint32_t count = log->pending;
+    const struct flash_log_header *header;
+
+    for (uint32_t back = 0; (header = flash_log_stored_sector(log, back)); back++) {
+        count += header->count;
+    }
+    return count;
+}
+
+// Copia o registro de idade 'age' (0 = o mais recente); false se não houver tantos
+bool flash_log_read(const flash_log_t *log, uint32_t age, void *out) {
+    const uint8_t *records = log->sector + sizeof(struct flash_log_header);
+    uint count = log->pending;
+    const struct flash_log_header *header;
+
+    for (uint32_t back = 0; age >= count; back++) {
+        age -= count;
+        if (!(header = flash_log_stored_sector(log, back))) {
+            return false;
+        }
+        records = (const uint8_t *) (header + 1);
+        count = header->count;
+    }
+
+    memcpy(out, records + (count - 1 - age) * log->record_size, log->record_size);
+    return true;
+}
+
+// Contadores; amplificação de escrita = flash_bytes / payload_bytes
+void flash_log_get_stats(const flash_log_t *log, struct flash_log_stats *out) {
+    *out = log->stats;
+}
@@ -0,0 +1,62 @@
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+
+#ifndef flash_log_inc_h
+#define flash_log_inc_h
+
+// Registro circular na flash interna: registros de tamanho fixo acumulam num setor em RAM e o
+// setor inteiro (4 KiB) é apagado e gravado de uma vez, em rodízio por uma região de setores
+// (todos se desgastam por igual). Cada setor leva um número de sequência, e o mais novo é
+// achado na partida por busca binária
+#define flash_log_magic 0x474F4C54u // "TLOG"
+
+// Cabeçalho de cada setor; os registros vêm logo depois
+struct flash_log_header {
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t record_size;
+    uint16_t count;   // registros no setor
+    uint32_t crc;     // CRC-32 do cabeçalho (com crc = 0) e dos registros
+};
+
+#define flash_log_payload_size (FLASH_SECTOR_SIZE - sizeof(struct flash_log_header))
+
+struct flash_log_stats {
+    uint32_t commits;       // setores gravados
+    uint32_t failures;      // gravações recusadas (flash_safe_execute não conseguiu a exclusividade)
+    uint64_t records;       // registros acrescentados
+    uint64_t payload_bytes; // bytes de registros gravados
+    uint64_t flash_bytes;   // bytes apagados e regravados (um setor por gravação)
+    uint32_t last_commit_us, max_commit_us;
+    uint32_t erase_us, program_us; // partes da última gravação
+    uint32_t longest_lockout_us;   // maior pausa imposta ao outro núcleo (uma operação na flash)
+};
+
+// Resultado de flash_log_append
+typedef enum {
+    flash_log_rejected = 0,  // o setor cheio não pôde ser gravado: o registro não entrou
+    flash_log_buffered = 1,  // o registro entrou no setor em RAM
+    flash_log_committed = 2, // o registro entrou e um setor foi gravado na flash
+} flash_log_result_t;
+
+typedef struct {
+    uint32_t offset;      // início da região, a partir do início da flash (múltiplo de 4 KiB)
+    uint16_t sectors;
+    uint16_t record_size;
+    uint16_t capacity;    // registros por setor
+    uint16_t head;        // próximo setor a gravar
+    uint32_t sequence;    // sequência do próximo setor
+    uint32_t stored;      // setores válidos na região (até 'sectors')
+    uint16_t pending;     // registros no setor em RAM
+    uint8_t sector[FLASH_SECTOR_SIZE] __attribute__((aligned(4)));
+    struct flash_log_stats stats;
+} flash_log_t;
+
+extern bool flash_log_init(flash_log_t *log, uint32_t offset, uint sectors, uint record_size);
+extern flash_log_result_t flash_log_append(flash_log_t *log, const void *record);
+extern bool flash_log_commit(flash_log_t *log);
+extern uint32_t flash_log_count(const flash_log_t *log);
+extern bool flash_log_read(const flash_log_t *log, uint32_t age, void *out);
+extern void flash_log_get_stats(const flash_log_t *log, struct flash_log_stats *out);
+
+#endif
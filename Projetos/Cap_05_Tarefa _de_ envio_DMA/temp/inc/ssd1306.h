@@ -1,17 +1,133 @@
-#include "ssd1306_i2c.h"
-extern void calculate_render_area_buffer_length(struct render_area *area);
-extern void ssd1306_send_command(uint8_t cmd);
-extern void ssd1306_send_command_list(uint8_t *ssd, int number);
-extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
-extern void ssd1306_init();
-extern void ssd1306_scroll(bool set);
-extern void render_on_display(uint8_t *ssd, struct render_area *area);
-extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
-extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
-extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
-extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
-extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
-extern void ssd1306_config(ssd1306_t *ssd);
-extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
-extern void ssd1306_send_data(ssd1306_t *ssd);
-extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
\ No newline at end of file
+#include "ssd1306_i2c.h"
+extern ssd1306_framebuffer_t ssd1306_framebuffer;
+extern ssd1306_t ssd1306_default_display;
+extern const ssd1306_font_t ssd1306_font_5x8;
+extern const ssd1306_font_t ssd1306_font_5x8_prop;
+extern void calculate_render_area_buffer_length(struct render_area *area);
+extern void ssd1306_send_command(uint8_t cmd);
+extern void ssd1306_send_command_list(uint8_t *ssd, int number);
+extern void ssd1306_send_buffer(const uint8_t ssd[], int buffer_length);
+extern void ssd1306_init();
+extern void ssd1306_scroll(bool set);
+extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern void ssd1306_clear_dirty();
+extern void ssd1306_mark_dirty(int x_0, int y_0, int x_1, int y_1);
+extern void ssd1306_set_dirty_tracking(bool enable);
+extern bool ssd1306_next_dirty_area(int page, struct render_area *area);
+extern int render_dirty_on_display(uint8_t *ssd);
+extern void ssd1306_add_traffic(enum ssd1306_operation op, uint32_t transactions, uint32_t bytes);
+extern void ssd1306_get_traffic(enum ssd1306_operation op, struct ssd1306_traffic *out);
+extern void ssd1306_reset_traffic();
+extern uint32_t ssd1306_get_bytes_on_wire();
+extern uint32_t ssd1306_display_bytes_on_wire(ssd1306_t *display);
+extern bool ssd1306_transport_write(ssd1306_t *display, const uint8_t *buffer, size_t length);
+extern bool ssd1306_transport_write_data(ssd1306_t *display, uint8_t control, const uint8_t *data, size_t length);
+extern int ssd1306_fifo_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t control, const uint8_t *data, size_t length, uint timeout_us);
+extern uint ssd1306_transport_negotiate(ssd1306_t *display);
+extern uint ssd1306_transport_baudrate(i2c_inst_t *i2c);
+extern uint ssd1306_transport_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+extern void ssd1306_transport_get_stats(ssd1306_t *display, struct ssd1306_link_stats *out);
+extern void ssd1306_transport_reset_stats(ssd1306_t *display);
+extern void ssd1306_async_init(ssd1306_async_callback_t callback);
+extern bool ssd1306_async_busy();
+extern void ssd1306_async_wait();
+extern int ssd1306_async_flush(uint8_t *ssd, struct render_area *area);
+extern int ssd1306_async_flush_dirty(uint8_t *ssd);
+extern uint32_t ssd1306_async_errors();
+extern bool ssd1306_async_claim(const void *who);
+extern void ssd1306_async_release(const void *who);
+extern bool ssd1306_async_busy_owned(const void *who);
+extern int ssd1306_async_flush_owned(const void *who, uint8_t *ssd, struct render_area *area);
+extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
+extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
+extern int ssd1306_draw_glyph(uint8_t *ssd, int x, int y, uint8_t code, const ssd1306_font_t *font);
+extern int ssd1306_draw_text(uint8_t *ssd, int x, int y, const char *text, const ssd1306_font_t *font);
+extern int ssd1306_text_width(const char *text, const ssd1306_font_t *font);
+extern uint8_t ssd1306_decode_char(const char **text);
+extern int ssd1306_glyph_advance(uint8_t code, const ssd1306_font_t *font);
+extern void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, ssd1306_draw_mode_t mode);
+extern void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_clear_region(uint8_t *ssd, int x, int y, int width, int height);
+extern void ssd1306_invert_region(uint8_t *ssd, int x, int y, int width, int height);
+extern void ssd1306_draw_circle(uint8_t *ssd, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_fill_circle(uint8_t *ssd, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_blit(uint8_t *ssd, int x, int y, const ssd1306_bitmap_t *bitmap, int src_x, int src_y, int width, int height);
+extern void ssd1306_draw_image(uint8_t *ssd, int x, int y, const ssd1306_bitmap_t *bitmap);
+extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+extern void ssd1306_config(ssd1306_t *ssd);
+extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+extern void ssd1306_send_data(ssd1306_t *ssd);
+extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
+extern void ssd1306_display_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer);
+extern void ssd1306_display_clear_dirty(ssd1306_t *display);
+extern void ssd1306_display_mark_dirty(ssd1306_t *display, int x_0, int y_0, int x_1, int y_1);
+extern void ssd1306_display_set_dirty_tracking(ssd1306_t *display, bool enable);
+extern bool ssd1306_display_next_dirty_area(ssd1306_t *display, int page, struct render_area *area);
+extern int ssd1306_display_flush_dirty(ssd1306_t *display);
+extern void ssd1306_display_render_area(ssd1306_t *display, struct render_area *area, const uint8_t *data);
+extern void ssd1306_display_scroll_horizontal(ssd1306_t *display, bool left, uint8_t start_page, uint8_t end_page, ssd1306_scroll_interval_t interval);
+extern void ssd1306_display_scroll_stop(ssd1306_t *display);
+extern void ssd1306_display_set_pixel(ssd1306_t *display, int x, int y, bool set);
+extern void ssd1306_display_draw_line(ssd1306_t *display, int x_0, int y_0, int x_1, int y_1, bool set);
+extern int ssd1306_display_draw_glyph(ssd1306_t *display, int x, int y, uint8_t code, const ssd1306_font_t *font);
+extern int ssd1306_display_draw_text(ssd1306_t *display, int x, int y, const char *text, const ssd1306_font_t *font);
+extern void ssd1306_display_fill_rect(ssd1306_t *display, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_draw_hline(ssd1306_t *display, int x_0, int x_1, int y, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_draw_vline(ssd1306_t *display, int x, int y_0, int y_1, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_draw_rect(ssd1306_t *display, int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_clear_region(ssd1306_t *display, int x, int y, int width, int height);
+extern void ssd1306_display_invert_region(ssd1306_t *display, int x, int y, int width, int height);
+extern void ssd1306_display_draw_circle(ssd1306_t *display, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_fill_circle(ssd1306_t *display, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_display_blit(ssd1306_t *display, int x, int y, const ssd1306_bitmap_t *bitmap, int src_x, int src_y, int width, int height);
+extern void ssd1306_display_draw_image(ssd1306_t *display, int x, int y, const ssd1306_bitmap_t *bitmap);
+extern void ssd1306_console_init(ssd1306_console_t *console, ssd1306_t *display, const ssd1306_font_t *font);
+extern void ssd1306_console_write(ssd1306_console_t *console, const char *text);
+extern void ssd1306_console_printf(ssd1306_console_t *console, const char *format, ...);
+extern void ssd1306_console_clear(ssd1306_console_t *console);
+extern void ssd1306_widget_init_label(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, const ssd1306_font_t *font);
+extern void ssd1306_widget_init_number(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, const ssd1306_font_t *font, int columns, int decimals);
+extern void ssd1306_widget_init_bar(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, int width, int height, int32_t min, int32_t max);
+extern void ssd1306_widget_init_icon(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y);
+extern bool ssd1306_widget_set_text(ssd1306_widget_t *widget, const char *text);
+extern bool ssd1306_widget_set_number(ssd1306_widget_t *widget, int32_t value);
+extern bool ssd1306_widget_set_bar(ssd1306_widget_t *widget, int32_t value);
+extern bool ssd1306_widget_set_icon(ssd1306_widget_t *widget, const ssd1306_bitmap_t *bitmap);
+extern void ssd1306_widget_invalidate(ssd1306_widget_t *widget);
+extern void ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_t *display, int x, int page, int width, int pages, int samples_per_column);
+extern void ssd1306_chart_set_range(ssd1306_chart_t *chart, int32_t min, int32_t max);
+extern bool ssd1306_chart_push(ssd1306_chart_t *chart, int32_t value);
+extern void ssd1306_chart_get_range(const ssd1306_chart_t *chart, int32_t *min, int32_t *max);
+extern void ssd1306_gray_init(ssd1306_gray_t *gray, int x, int page, int width, int pages);
+extern void ssd1306_gray_clear(ssd1306_gray_t *gray);
+extern void ssd1306_gray_set_pixel(ssd1306_gray_t *gray, int x, int y, uint8_t level);
+extern uint8_t ssd1306_gray_get_pixel(ssd1306_gray_t *gray, int x, int y);
+extern void ssd1306_gray_fill_rect(ssd1306_gray_t *gray, int x, int y, int width, int height, uint8_t level);
+extern void ssd1306_gray_draw_image(ssd1306_gray_t *gray, int x, int y, const ssd1306_bitmap_t *bitmap, uint8_t level);
+extern int ssd1306_gray_draw_text(ssd1306_gray_t *gray, int x, int y, const char *text, const ssd1306_font_t *font, uint8_t level);
+extern uint32_t ssd1306_gray_frame_us(ssd1306_gray_t *gray);
+extern void ssd1306_gray_start(ssd1306_gray_t *gray, uint32_t period_us);
+extern void ssd1306_gray_stop(ssd1306_gray_t *gray);
+extern void ssd1306_gray_get_stats(ssd1306_gray_t *gray, struct ssd1306_gray_stats *out);
+extern void ssd1306_gray_benchmark(ssd1306_gray_t *gray, uint32_t duration_ms, struct ssd1306_gray_stats *out);
+extern void ssd1306_service_start(ssd1306_t *display);
+extern bool ssd1306_service_poll();
+extern bool ssd1306_service_idle();
+extern void ssd1306_service_get_stats(struct ssd1306_service_stats *out);
+extern void ssd1306_service_draw_text(int x, int y, const char *text, const ssd1306_font_t *font);
+extern void ssd1306_service_fill_rect(int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_service_draw_rect(int x, int y, int width, int height, ssd1306_draw_mode_t mode);
+extern void ssd1306_service_draw_line(int x_0, int y_0, int x_1, int y_1, ssd1306_draw_mode_t mode);
+extern void ssd1306_service_draw_circle(int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_service_fill_circle(int x_c, int y_c, int radius, ssd1306_draw_mode_t mode);
+extern void ssd1306_service_draw_image(int x, int y, const ssd1306_bitmap_t *bitmap);
+extern void ssd1306_service_chart_push(ssd1306_chart_t *chart, int32_t value);
+extern void ssd1306_service_widget_set_text(ssd1306_widget_t *widget, const char *text);
+extern void ssd1306_service_widget_set_number(ssd1306_widget_t *widget, int32_t value);
+extern void ssd1306_service_widget_set_bar(ssd1306_widget_t *widget, int32_t value);
+extern void ssd1306_service_widget_set_icon(ssd1306_widget_t *widget, const ssd1306_bitmap_t *bitmap);
+extern void ssd1306_service_flush();
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "ssd1306.h"
+
+// Envio não bloqueante do framebuffer do painel padrão (ssd1306_default_display): o DMA
+// alimenta o FIFO de transmissão do controlador i2c do painel.
+// Cada palavra escrita em IC_DATA_CMD leva o byte nos bits 0-7 e o pedido de STOP no bit 9.
+// Após um STOP com dados ainda no FIFO, o controlador gera um novo START sozinho, então
+// comandos de endereço e dados de várias janelas seguem num único fluxo de DMA.
+// Um dono exclusivo (ssd1306_async_claim) pode tomar o envio para si, ex.: o rodízio de cinza,
+// que envia de um timer: enquanto ele o tiver, as chamadas dos outros contextos são recusadas,
+// porque o estado abaixo (buffers, prazo, abort, contadores de tráfego) não é protegido contra
+// chamadas simultâneas
+
+// Pior caso: todas as páginas sujas, cada uma com byte de controle + 6 comandos + byte de controle + dados
+#define ssd1306_async_max_words (ssd1306_n_pages * (ssd1306_width + 8))
+
+// Buffers de transmissão duplos: o quadro N+1 é montado enquanto o quadro N ainda está no barramento
+static uint16_t tx_buffer[2][ssd1306_async_max_words];
+static int tx_length[2];
+
+static int dma_chan = -1;
+static volatile int active = -1;  // buffer sendo enviado pelo DMA
+static volatile int pending = -1; // buffer pronto aguardando o término do atual
+static ssd1306_async_callback_t done_callback = NULL;
+static uint32_t errors = 0;
+
+// Início e prazo do envio em curso: o dobro do tempo teórico no barramento, mais uma folga.
+// Passado o prazo (ex.: SCL preso em nível baixo), o envio é abandonado em vez de travar a espera
+static volatile uint32_t started_us = 0;
+static volatile uint32_t deadline_us = 0;
+
+// Abort pedido ao controlador e ainda não concluído: enquanto ele descarta o FIFO, uma palavra
+// escrita em IC_DATA_CMD se perderia, então o painel continua ocupado
+static bool aborting = false;
+static uint32_t abort_started_us = 0;
+
+static const void *volatile owner = NULL; // dono exclusivo, ou NULL
+
+static void ssd1306_async_start(int index) {
+    active = index;
+    started_us = time_us_32();
+    deadline_us = (uint32_t) ((uint64_t) tx_length[index] * 9 * 2000000 / ssd1306_transport_baudrate(ssd1306_default_display.i2c_port))
+                  + ssd1306_i2c_timeout_margin_us;
+    dma_channel_transfer_from_buffer_now(dma_chan, tx_buffer[index], tx_length[index]);
+}
+
+// Fim de um envio: encadeia o buffer pendente (se houver) e avisa a aplicação
+static void ssd1306_async_irq_handler() {
+    if (dma_chan < 0 || !dma_channel_get_irq1_status(dma_chan)) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(dma_chan);
+
+    if (pending >= 0) {
+        int next = pending;
+        pending = -1;
+        ssd1306_async_start(next);
+    }
+    else {
+        active = -1;
+    }
+
+    if (done_callback) {
+        done_callback();
+    }
+}
+
+// Reserva um canal de DMA ligado ao DREQ de transmissão do i2c do painel padrão
+void ssd1306_async_init(ssd1306_async_callback_t callback) {
+    done_callback = callback;
+
+    i2c_inst_t *i2c = ssd1306_default_display.i2c_port;
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = ssd1306_default_display.address;
+    hw->enable = 1;
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(i2c, true));
+    dma_channel_configure(dma_chan, &cfg, &hw->data_cmd, NULL, 0, false);
+
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_1, ssd1306_async_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+// Abandona o envio em curso e o pendente, liberando os dois buffers
+static void ssd1306_async_abandon() {
+    irq_set_enabled(DMA_IRQ_1, false);
+    dma_channel_set_irq1_enabled(dma_chan, false);
+    dma_channel_abort(dma_chan);
+    dma_channel_acknowledge_irq1(dma_chan);
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    active = -1;
+    pending = -1;
+    errors++;
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+// Há dados a caminho do display (DMA ativo, buffer pendente ou FIFO não vazio)?
+static bool ssd1306_async_poll() {
+    i2c_hw_t *hw = i2c_get_hw(ssd1306_default_display.i2c_port);
+
+    // O abort termina quando o controlador limpa ABORT (e levanta TX_ABRT). Se nem isso acontecer
+    // dentro da folga, o controlador é desligado e religado, o que esvazia o FIFO à força
+    if (aborting) {
+        if ((hw->enable & I2C_IC_ENABLE_ABORT_BITS) && !(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) {
+            if (time_us_32() - abort_started_us <= ssd1306_i2c_timeout_margin_us) {
+                return true;
+            }
+            hw->enable = 0;
+            hw->enable = 1;
+        }
+        (void) hw->clr_tx_abrt;
+        aborting = false;
+        return false;
+    }
+
+    // NACK ou perda de arbitragem: o controlador descarta o FIFO, então o envio em curso é abandonado
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        ssd1306_async_abandon();
+        (void) hw->clr_tx_abrt;
+    }
+
+    bool hardware_busy = !(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS);
+    bool expired = time_us_32() - started_us > deadline_us;
+
+    // Barramento preso: pede ao controlador que aborte a transferência e deixa de esperar pelo
+    // DMA; o painel só fica livre quando o abort terminar
+    if (expired && (active >= 0 || pending >= 0 || hardware_busy)) {
+        hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+        aborting = true;
+        abort_started_us = time_us_32();
+        if (active >= 0 || pending >= 0) {
+            ssd1306_async_abandon();
+        }
+        return true;
+    }
+
+    return active >= 0 || pending >= 0 || hardware_busy;
+}
+
+// Indica se ainda há dados a caminho do display. Com um dono exclusivo, o envio está sempre
+// ocupado para os outros
+bool ssd1306_async_busy() {
+    if (owner) {
+        return true;
+    }
+    return ssd1306_async_poll();
+}
+
+// Espera o display receber tudo; necessário antes de usar as funções bloqueantes do driver.
+// Não pode ser chamada enquanto houver um dono exclusivo (a espera não terminaria)
+void ssd1306_async_wait() {
+    assert(!owner);
+    if (owner) {
+        return;
+    }
+    while (ssd1306_async_poll()) {
+        tight_loop_contents();
+    }
+}
+
+// Acrescenta ao fluxo uma janela: transação de comandos de endereço seguida da transação de dados
+static int ssd1306_async_pack(uint16_t *words, int n, const uint8_t *ssd, const struct render_area *area) {
+    const uint8_t commands[] = {
+        ssd1306_set_column_address, area->start_column, area->end_column,
+        ssd1306_set_page_address, area->start_page, area->end_page
+    };
+
+    words[n++] = 0x00; // byte de controle: sequência de comandos
+    for (int i = 0; i < count_of(commands); i++) {
+        words[n++] = commands[i];
+    }
+    words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    words[n++] = 0x40; // byte de controle: dados
+    for (int page = area->start_page; page <= area->end_page; page++) {
+        const uint8_t *row = ssd + page * ssd1306_width;
+        for (int column = area->start_column; column <= area->end_column; column++) {
+            words[n++] = row[column];
+        }
+    }
+    words[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    return n;
+}
+
+// Escolhe um buffer de transmissão livre, esperando apenas se os dois estiverem ocupados ou se
+// um abort ainda estiver em curso
+static int ssd1306_async_acquire() {
+    // ssd1306_async_poll() também libera os buffers se o controlador abortar o envio
+    while ((pending >= 0 || aborting) && ssd1306_async_poll()) {
+        tight_loop_contents();
+    }
+    return active == 0 ? 1 : 0;
+}
+
+// Dispara (ou enfileira) o buffer montado; retorna os bytes que irão ao barramento
+static int ssd1306_async_submit(int index, int transactions) {
+    if (tx_length[index] == 0) {
+        return 0;
+    }
+
+    irq_set_enabled(DMA_IRQ_1, false);
+    if (active < 0) {
+        ssd1306_async_start(index);
+    }
+    else {
+        pending = index;
+    }
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    int bytes = tx_length[index] + transactions; // +1 byte de endereço por transação
+    ssd1306_add_traffic(ssd1306_op_render, transactions, bytes);
+    return bytes;
+}
+
+static int ssd1306_async_send_window(uint8_t *ssd, struct render_area *area) {
+    int index = ssd1306_async_acquire();
+
+    tx_length[index] = ssd1306_async_pack(tx_buffer[index], 0, ssd, area);
+    return ssd1306_async_submit(index, 2);
+}
+
+// Envia uma janela do framebuffer (layout completo de ssd1306_buffer_length bytes) sem bloquear.
+// Recusada (0 bytes) enquanto houver um dono exclusivo
+int ssd1306_async_flush(uint8_t *ssd, struct render_area *area) {
+    assert(!owner);
+    if (owner) {
+        return 0;
+    }
+    return ssd1306_async_send_window(ssd, area);
+}
+
+// Envia sem bloquear todas as janelas sujas do framebuffer, num único fluxo de DMA. Recusada
+// (0 bytes, as regiões continuam sujas) enquanto houver um dono exclusivo
+int ssd1306_async_flush_dirty(uint8_t *ssd) {
+    assert(!owner);
+    if (owner) {
+        return 0;
+    }
+
+    int index = ssd1306_async_acquire();
+    struct render_area area;
+    int n = 0, transactions = 0;
+
+    for (int page = 0; ssd1306_next_dirty_area(page, &area); page = area.end_page + 1) {
+        n = ssd1306_async_pack(tx_buffer[index], n, ssd, &area);
+        transactions += 2;
+    }
+    ssd1306_clear_dirty();
+
+    tx_length[index] = n;
+    return ssd1306_async_submit(index, transactions);
+}
+
+// Toma o envio para 'who' (do contexto principal, com o envio livre); false se já tem dono.
+// Daí em diante só ssd1306_async_busy_owned e ssd1306_async_flush_owned, com o mesmo 'who',
+// usam o envio, até ssd1306_async_release
+bool ssd1306_async_claim(const void *who) {
+    if (owner) {
+        return false;
+    }
+    owner = who;
+    return true;
+}
+
+void ssd1306_async_release(const void *who) {
+    assert(owner == who);
+    if (owner == who) {
+        owner = NULL;
+    }
+}
+
+// ssd1306_async_busy para o dono exclusivo
+bool ssd1306_async_busy_owned(const void *who) {
+    assert(owner == who);
+    return owner != who || ssd1306_async_poll();
+}
+
+// ssd1306_async_flush para o dono exclusivo
+int ssd1306_async_flush_owned(const void *who, uint8_t *ssd, struct render_area *area) {
+    assert(owner == who);
+    if (owner != who) {
+        return 0;
+    }
+    return ssd1306_async_send_window(ssd, area);
+}
+
+// Número de envios abortados pelo controlador i2c (NACK, perda de arbitragem) ou abandonados
+// por estourar o prazo
+uint32_t ssd1306_async_errors() {
+    return errors;
+}
+
+// Transação bloqueante com o byte de controle 'control' seguido de 'data', escrita palavra a
+// palavra no FIFO como no envio por DMA: o byte de controle é a primeira palavra, então o
+// buffer do chamador não precisa reservar um byte antes dos dados. Mesmo contrato de
+// i2c_write_timeout_us: retorna os bytes enviados (length + 1), PICO_ERROR_GENERIC se o
+// controlador abortar (NACK) ou PICO_ERROR_TIMEOUT. Não pode ser usada com um envio por DMA em curso
+int ssd1306_fifo_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t control, const uint8_t *data, size_t length, uint timeout_us) {
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    uint32_t start = time_us_32();
+
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    (void) hw->clr_tx_abrt;
+    (void) hw->clr_stop_det;
+
+    // Depois de um abort o controlador descarta o FIFO e gera o STOP sozinho
+    for (size_t i = 0; i <= length && !(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS); i++) {
+        uint32_t word = i == 0 ? control : data[i - 1];
+        if (i == length) {
+            word |= I2C_IC_DATA_CMD_STOP_BITS;
+        }
+        while (!i2c_get_write_available(i2c)) {
+            if (time_us_32() - start > timeout_us) {
+                hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+                return PICO_ERROR_TIMEOUT;
+            }
+        }
+        hw->data_cmd = word;
+    }
+
+    while (!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS)) {
+        if (time_us_32() - start > timeout_us) {
+            hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+            return PICO_ERROR_TIMEOUT;
+        }
+    }
+    (void) hw->clr_stop_det;
+
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void) hw->clr_tx_abrt;
+        return PICO_ERROR_GENERIC;
+    }
+    return (int) length + 1;
+}
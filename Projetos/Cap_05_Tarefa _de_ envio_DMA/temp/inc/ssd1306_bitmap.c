@@ -0,0 +1,145 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306_core.h"
+
+// Leitor de linhas de página de um bitmap. Imagens compactadas são decodificadas sob demanda,
+// uma página por vez, guardando apenas as duas últimas (o suficiente para um deslocamento em y)
+typedef struct {
+    const ssd1306_bitmap_t *bitmap;
+    const uint8_t *next;   // próximo byte do fluxo compactado
+    int run;               // bytes restantes da repetição atual
+    int literal;           // bytes restantes do trecho literal atual
+    uint8_t value;         // byte repetido
+    int decoded_page;      // última página decodificada (-1: nenhuma)
+    uint8_t rows[2][255];  // páginas decodificadas, indexadas pela paridade
+} bitmap_reader_t;
+
+static void bitmap_reader_init(bitmap_reader_t *reader, const ssd1306_bitmap_t *bitmap) {
+    reader->bitmap = bitmap;
+    reader->next = bitmap->data;
+    reader->run = 0;
+    reader->literal = 0;
+    reader->decoded_page = -1;
+}
+
+// Próximo byte do fluxo compactado
+static inline uint8_t bitmap_reader_byte(bitmap_reader_t *reader) {
+    while (reader->run == 0 && reader->literal == 0) {
+        uint8_t header = *reader->next++;
+        if (header & 0x80) {
+            reader->run = (header & 0x7F) + 1;
+            reader->value = *reader->next++;
+        }
+        else {
+            reader->literal = header + 1;
+        }
+    }
+
+    if (reader->run) {
+        reader->run--;
+        return reader->value;
+    }
+    reader->literal--;
+    return *reader->next++;
+}
+
+// Linha de 'width' bytes da página 'page' do bitmap
+static const uint8_t *bitmap_reader_row(bitmap_reader_t *reader, int page) {
+    const ssd1306_bitmap_t *bitmap = reader->bitmap;
+
+    if (!bitmap->rle) {
+        return bitmap->data + page * bitmap->width;
+    }
+
+    while (reader->decoded_page < page) {
+        uint8_t *row = reader->rows[(reader->decoded_page + 1) & 1];
+        for (int column = 0; column < bitmap->width; column++) {
+            row[column] = bitmap_reader_byte(reader);
+        }
+        reader->decoded_page++;
+    }
+    return reader->rows[page & 1];
+}
+
+// Copia o retângulo (src_x, src_y, width, height) do bitmap para o framebuffer na posição (x, y).
+// Nenhuma coordenada precisa estar alinhada a páginas: cada byte de destino recebe os bits das
+// duas páginas de origem que o cobrem, deslocados e mascarados. Só as colunas que realmente
+// mudaram são marcadas como sujas; o envio fica a cargo de quem chama (um único flush)
+ssd1306_core void ssd1306_blit_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, const ssd1306_bitmap_t *bitmap, int src_x, int src_y, int width, int height) {
+    // Recorte contra o bitmap
+    if (src_x < 0) { x -= src_x; width += src_x; src_x = 0; }
+    if (src_y < 0) { y -= src_y; height += src_y; src_y = 0; }
+    if (src_x + width > bitmap->width) width = bitmap->width - src_x;
+    if (src_y + height > bitmap->height) height = bitmap->height - src_y;
+
+    // Recorte contra a tela
+    if (x < 0) { src_x -= x; width += x; x = 0; }
+    if (y < 0) { src_y -= y; height += y; y = 0; }
+    if (x + width > columns) width = columns - x;
+    if (y + height > rows) height = rows - y;
+
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    const int src_pages = (bitmap->height + 7) / 8;
+    bitmap_reader_t reader;
+    bitmap_reader_init(&reader, bitmap);
+
+    int row = y;
+    while (row < y + height) {
+        int page = row / 8;
+        int offset = row % 8;
+        int count = 8 - offset;
+        if (count > y + height - row) {
+            count = y + height - row;
+        }
+
+        // Linha de origem correspondente e as duas páginas que a contêm
+        int src_row = src_y + (row - y);
+        int src_page = src_row / 8;
+        int shift = src_row % 8;
+        const uint8_t *upper = bitmap_reader_row(&reader, src_page);
+        const uint8_t *lower = (shift && src_page + 1 < src_pages) ? bitmap_reader_row(&reader, src_page + 1) : NULL;
+
+        uint8_t mask = ((1u << count) - 1) << offset;
+        uint8_t *dest = ssd + page * columns + x;
+        int changed_min = width, changed_max = -1;
+
+        for (int i = 0; i < width; i++) {
+            uint16_t bits = upper[src_x + i];
+            if (lower) {
+                bits |= lower[src_x + i] << 8;
+            }
+            uint8_t byte = (dest[i] & ~mask) | ((uint8_t) ((bits >> shift) << offset) & mask);
+
+            if (byte != dest[i]) {
+                dest[i] = byte;
+                if (i < changed_min) changed_min = i;
+                changed_max = i;
+            }
+        }
+
+        if (changed_max >= 0) {
+            ssd1306_dirty_span(dirty, x + changed_min, x + changed_max, page, page);
+        }
+        row += count;
+    }
+}
+
+void ssd1306_blit(uint8_t *ssd, int x, int y, const ssd1306_bitmap_t *bitmap, int src_x, int src_y, int width, int height) {
+    ssd1306_legacy(ssd1306_blit_core, ssd, x, y, bitmap, src_x, src_y, width, height);
+}
+
+void ssd1306_display_blit(ssd1306_t *display, int x, int y, const ssd1306_bitmap_t *bitmap, int src_x, int src_y, int width, int height) {
+    ssd1306_dispatch(display, ssd1306_blit_core, x, y, bitmap, src_x, src_y, width, height);
+}
+
+// Desenha o bitmap inteiro com o canto superior esquerdo em (x, y)
+void ssd1306_draw_image(uint8_t *ssd, int x, int y, const ssd1306_bitmap_t *bitmap) {
+    ssd1306_blit(ssd, x, y, bitmap, 0, 0, bitmap->width, bitmap->height);
+}
+
+void ssd1306_display_draw_image(ssd1306_t *display, int x, int y, const ssd1306_bitmap_t *bitmap) {
+    ssd1306_display_blit(display, x, y, bitmap, 0, 0, bitmap->width, bitmap->height);
+}
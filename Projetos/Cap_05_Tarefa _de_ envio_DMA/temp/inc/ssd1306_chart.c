@@ -0,0 +1,181 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+// Gráfico rolante sobre o framebuffer de um painel. A janela ocupa páginas inteiras, então cada
+// coluna do gráfico é um byte por página escrito direto no framebuffer, e a rolagem é um memmove
+// por página. Cada atualização marca como suja só a janela do gráfico: com o rastreamento de
+// regiões sujas ligado, o flush seguinte envia só ela (128x2 páginas a 400 kHz: ~7 ms)
+
+// Coluna 'index' do histórico, contando a partir da mais antiga
+static inline int ssd1306_chart_slot(const ssd1306_chart_t *chart, int index) {
+    return (chart->head + index) % chart->width;
+}
+
+// Linha da janela (0 = topo) onde cai 'value' na escala atual
+static int ssd1306_chart_row(const ssd1306_chart_t *chart, int32_t value) {
+    int rows = chart->pages * ssd1306_page_height;
+    int32_t span = chart->scale_max - chart->scale_min;
+
+    if (value <= chart->scale_min) return rows - 1;
+    if (value >= chart->scale_max) return 0;
+    return rows - 1 - (int) (((int64_t) (value - chart->scale_min) * (rows - 1) + span / 2) / span);
+}
+
+// Desenha a faixa [low, high] na coluna 'column' da janela, um byte por página
+static void ssd1306_chart_draw_column(ssd1306_chart_t *chart, int column, int32_t low, int32_t high) {
+    ssd1306_t *display = chart->display;
+    uint8_t *pixels = display->ram_buffer + 1 + chart->page * display->width + chart->x + column;
+    int top = ssd1306_chart_row(chart, high);
+    int bottom = ssd1306_chart_row(chart, low);
+
+    for (int page = 0; page < chart->pages; page++) {
+        int first = top - page * ssd1306_page_height;
+        int last = bottom - page * ssd1306_page_height;
+        if (first < 0) first = 0;
+        if (last > 7) last = 7;
+
+        *pixels = first <= last ? (uint8_t) ((0xFFu << first) & (0xFFu >> (7 - last))) : 0;
+        pixels += display->width;
+    }
+}
+
+// Faixa desenhada na coluna 'index' do histórico: a envoltória das suas amostras, estendida até
+// a coluna anterior para que o traço fique contínuo
+static void ssd1306_chart_column_span(const ssd1306_chart_t *chart, int index, int32_t *low, int32_t *high) {
+    int slot = ssd1306_chart_slot(chart, index);
+    *low = chart->column_min[slot];
+    *high = chart->column_max[slot];
+
+    if (index > 0) {
+        int previous = ssd1306_chart_slot(chart, index - 1);
+        if (chart->column_max[previous] < *low) *low = chart->column_max[previous];
+        if (chart->column_min[previous] > *high) *high = chart->column_min[previous];
+    }
+}
+
+// Marca a janela do gráfico como suja
+static void ssd1306_chart_mark(ssd1306_chart_t *chart) {
+    ssd1306_display_mark_dirty(chart->display, chart->x, chart->page * ssd1306_page_height,
+                               chart->x + chart->width - 1, (chart->page + chart->pages) * ssd1306_page_height - 1);
+}
+
+// Redesenha a janela inteira a partir do histórico (após mudar a escala)
+static void ssd1306_chart_redraw(ssd1306_chart_t *chart) {
+    int empty = chart->width - chart->count;
+
+    for (int column = 0; column < empty; column++) {
+        uint8_t *pixels = chart->display->ram_buffer + 1 + chart->page * chart->display->width + chart->x + column;
+        for (int page = 0; page < chart->pages; page++) {
+            *pixels = 0;
+            pixels += chart->display->width;
+        }
+    }
+    for (int index = 0; index < chart->count; index++) {
+        int32_t low, high;
+        ssd1306_chart_column_span(chart, index, &low, &high);
+        ssd1306_chart_draw_column(chart, empty + index, low, high);
+    }
+    ssd1306_chart_mark(chart);
+}
+
+// Escala automática: ajusta o eixo Y quando o histórico sai dele ou passa a ocupar menos da
+// metade dele (a histerese evita redesenhos a cada amostra). Retorna true se a escala mudou
+static bool ssd1306_chart_autoscale(ssd1306_chart_t *chart) {
+    int32_t low = INT32_MAX, high = INT32_MIN;
+
+    for (int index = 0; index < chart->count; index++) {
+        int slot = ssd1306_chart_slot(chart, index);
+        if (chart->column_min[slot] < low) low = chart->column_min[slot];
+        if (chart->column_max[slot] > high) high = chart->column_max[slot];
+    }
+
+    int64_t scale_span = (int64_t) chart->scale_max - chart->scale_min;
+    if (chart->count > 1 && low >= chart->scale_min && high <= chart->scale_max && ((int64_t) high - low) * 2 >= scale_span) {
+        return false;
+    }
+
+    // Margem de 1/8 da faixa em cada lado (ao menos 1), para que pequenas variações caibam
+    int32_t margin = (int32_t) (((int64_t) high - low) / 8) + 1;
+    chart->scale_min = low - margin;
+    chart->scale_max = high + margin;
+    chart->rescales++;
+    return true;
+}
+
+// Cria um gráfico na janela de colunas [x, x + width) e páginas [page, page + pages), com
+// escala automática. Cada coluna reúne 'samples_per_column' amostras
+void ssd1306_chart_init(ssd1306_chart_t *chart, ssd1306_t *display, int x, int page, int width, int pages, int samples_per_column) {
+    assert(x >= 0 && width > 1 && x + width <= display->width);
+    assert(page >= 0 && pages > 0 && page + pages <= display->pages && samples_per_column > 0);
+
+    memset(chart, 0, sizeof(*chart));
+    chart->display = display;
+    chart->x = x;
+    chart->width = width;
+    chart->page = page;
+    chart->pages = pages;
+    chart->samples_per_column = samples_per_column;
+    chart->auto_scale = true;
+    chart->scale_max = 1;
+
+    ssd1306_chart_redraw(chart);
+}
+
+// Fixa o eixo Y em [min, max] (desliga a escala automática) e redesenha o gráfico
+void ssd1306_chart_set_range(ssd1306_chart_t *chart, int32_t min, int32_t max) {
+    assert(max > min);
+
+    chart->auto_scale = false;
+    chart->scale_min = min;
+    chart->scale_max = max;
+    ssd1306_chart_redraw(chart);
+}
+
+// Faixa atual do eixo Y (para rótulos)
+void ssd1306_chart_get_range(const ssd1306_chart_t *chart, int32_t *min, int32_t *max) {
+    *min = chart->scale_min;
+    *max = chart->scale_max;
+}
+
+// Acrescenta uma amostra. Quando a coluna fica completa, o gráfico rola uma coluna (ou é
+// redesenhado, se a escala mudou). Retorna true se o framebuffer mudou
+bool ssd1306_chart_push(ssd1306_chart_t *chart, int32_t value) {
+    if (chart->pending == 0 || value < chart->pending_min) chart->pending_min = value;
+    if (chart->pending == 0 || value > chart->pending_max) chart->pending_max = value;
+    if (++chart->pending < chart->samples_per_column) {
+        return false;
+    }
+    chart->pending = 0;
+
+    // Nova coluna no fim do anel; com o histórico cheio, ela toma o lugar da mais antiga
+    int slot;
+    if (chart->count < chart->width) {
+        slot = ssd1306_chart_slot(chart, chart->count++);
+    }
+    else {
+        slot = chart->head;
+        chart->head = (chart->head + 1) % chart->width;
+    }
+    chart->column_min[slot] = chart->pending_min;
+    chart->column_max[slot] = chart->pending_max;
+
+    if (chart->auto_scale && ssd1306_chart_autoscale(chart)) {
+        ssd1306_chart_redraw(chart);
+        return true;
+    }
+
+    // Rola a janela uma coluna para a esquerda, página por página, e desenha só a coluna nova
+    uint8_t *row = chart->display->ram_buffer + 1 + chart->page * chart->display->width + chart->x;
+    for (int page = 0; page < chart->pages; page++) {
+        memmove(row, row + 1, chart->width - 1);
+        row += chart->display->width;
+    }
+
+    int32_t low, high;
+    ssd1306_chart_column_span(chart, chart->count - 1, &low, &high);
+    ssd1306_chart_draw_column(chart, chart->width - 1, low, high);
+    ssd1306_chart_mark(chart);
+    chart->columns_drawn++;
+    return true;
+}
@@ -0,0 +1,144 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+// Console de texto no estilo terminal. A GDDRAM tem sempre 8 páginas (64 linhas), mesmo nos
+// painéis de 32 linhas: elas formam um anel, e a tela mostra display->pages páginas a partir de
+// top_page. Uma linha nova custa o envio de uma página e, quando a tela rola, um comando de
+// linha inicial; o framebuffer do painel não é usado (não misture com os flushes do contexto)
+
+// Página da GDDRAM onde está a linha do cursor
+static inline uint8_t ssd1306_console_page(const ssd1306_console_t *console) {
+    return (console->top_page + console->row) % ssd1306_max_pages;
+}
+
+// Envia a linha atual (uma página) e, se a tela rolou, a nova linha inicial
+static void ssd1306_console_flush(ssd1306_console_t *console) {
+    if (console->line_dirty) {
+        uint8_t page = ssd1306_console_page(console);
+        struct render_area area = { .start_column = 0, .end_column = console->display->width - 1, .start_page = page, .end_page = page };
+        calculate_render_area_buffer_length(&area);
+        ssd1306_display_render_area(console->display, &area, console->line + 1);
+        console->line_dirty = false;
+    }
+
+    // A linha inicial só muda depois que a página exposta já tem o conteúdo novo
+    if (console->start_line_dirty) {
+        ssd1306_command(console->display, ssd1306_set_display_start_line | (console->top_page * ssd1306_page_height));
+        console->start_line_dirty = false;
+    }
+}
+
+// Passa para a linha seguinte, rolando a tela se o cursor já estiver na última linha
+static void ssd1306_console_newline(ssd1306_console_t *console) {
+    ssd1306_console_flush(console);
+
+    if (console->row + 1 < console->display->pages) {
+        console->row++;
+    }
+    else {
+        console->top_page = (console->top_page + 1) % ssd1306_max_pages;
+        console->start_line_dirty = true;
+    }
+
+    // A página que entra na tela ainda tem um conteúdo antigo: será reenviada, mesmo em branco
+    memset(console->line + 1, 0, console->display->width);
+    console->line_dirty = true;
+    console->x = 0;
+    console->newline_pending = false;
+}
+
+// Associa o console a um painel já inicializado e apaga toda a GDDRAM
+void ssd1306_console_init(ssd1306_console_t *console, ssd1306_t *display, const ssd1306_font_t *font) {
+    assert(font->height <= ssd1306_page_height);
+
+    console->display = display;
+    console->font = font;
+    console->top_page = 0;
+    console->row = 0;
+    console->x = 0;
+    console->newline_pending = false;
+
+    // 'line' vira um painel de uma página, para desenhar com as primitivas de contexto
+    memset(&console->line_view, 0, sizeof(console->line_view));
+    console->line_view.width = display->width;
+    console->line_view.height = ssd1306_page_height;
+    console->line_view.pages = 1;
+    console->line_view.ram_buffer = console->line;
+    console->line_view.bufsize = display->width + 1;
+    memset(console->line, 0, sizeof(console->line));
+
+    for (int page = 0; page < ssd1306_max_pages; page++) {
+        struct render_area area = { .start_column = 0, .end_column = display->width - 1, .start_page = page, .end_page = page };
+        calculate_render_area_buffer_length(&area);
+        ssd1306_display_render_area(display, &area, console->line + 1);
+    }
+
+    console->line_dirty = false;
+    console->start_line_dirty = true;
+    ssd1306_console_flush(console);
+}
+
+// Escreve texto UTF-8. '\n' passa à próxima linha, '\r' volta ao início da linha atual e
+// linhas mais largas que a tela quebram automaticamente. Envia só a linha alterada
+void ssd1306_console_write(ssd1306_console_t *console, const char *text) {
+    while (*text) {
+        if (*text == '\n') {
+            if (console->newline_pending) {
+                ssd1306_console_newline(console);
+            }
+            console->newline_pending = true;
+            text++;
+            continue;
+        }
+        if (*text == '\r') {
+            console->x = 0;
+            text++;
+            continue;
+        }
+
+        uint8_t code = ssd1306_decode_char(&text);
+        int advance = ssd1306_glyph_advance(code, console->font);
+
+        if (console->newline_pending || console->x + advance > console->display->width) {
+            ssd1306_console_newline(console);
+        }
+
+        ssd1306_display_draw_glyph(&console->line_view, console->x, 0, code, console->font);
+        console->x += advance;
+        console->line_dirty = true;
+    }
+
+    ssd1306_console_flush(console);
+}
+
+// Escreve texto formatado, como printf
+void ssd1306_console_printf(ssd1306_console_t *console, const char *format, ...) {
+    char buffer[128];
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    ssd1306_console_write(console, buffer);
+}
+
+// Limpa a tela e volta o cursor ao topo, sem rolar a GDDRAM inteira de volta
+void ssd1306_console_clear(ssd1306_console_t *console) {
+    memset(console->line + 1, 0, console->display->width);
+
+    for (int row = 0; row < console->display->pages; row++) {
+        uint8_t page = (console->top_page + row) % ssd1306_max_pages;
+        struct render_area area = { .start_column = 0, .end_column = console->display->width - 1, .start_page = page, .end_page = page };
+        calculate_render_area_buffer_length(&area);
+        ssd1306_display_render_area(console->display, &area, console->line + 1);
+    }
+
+    console->row = 0;
+    console->x = 0;
+    console->newline_pending = false;
+    console->line_dirty = false;
+}
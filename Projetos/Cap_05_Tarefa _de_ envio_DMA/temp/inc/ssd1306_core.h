@@ -0,0 +1,57 @@
+#include "ssd1306.h"
+
+#ifndef ssd1306_core_h
+#define ssd1306_core_h
+
+// Uso interno dos módulos do driver. Cada primitiva de desenho tem um núcleo sempre expandido
+// em linha, que recebe os pixels, a geometria do painel (columns x rows) e as regiões sujas
+// (NULL: sem rastreamento). A API legada e os painéis com a geometria de ssd1306_i2c.h chamam
+// o núcleo com constantes, e o compilador gera o laço especializado; só os outros painéis
+// passam pelo caminho com largura e altura em variáveis
+#define ssd1306_core static inline __attribute__((always_inline))
+
+// Regiões sujas de um painel, ou NULL se o rastreamento estiver desligado
+static inline struct dirty_region *ssd1306_dirty_of(ssd1306_t *display) {
+    return display->dirty_tracking ? &display->dirty : NULL;
+}
+
+// Chama o núcleo 'core' sobre o framebuffer de um contexto
+#define ssd1306_dispatch(display, core, ...) \
+    ((display)->width == ssd1306_width && (display)->height == ssd1306_height \
+        ? core((display)->ram_buffer + 1, ssd1306_width, ssd1306_height, ssd1306_dirty_of(display), __VA_ARGS__) \
+        : core((display)->ram_buffer + 1, (display)->width, (display)->height, ssd1306_dirty_of(display), __VA_ARGS__))
+
+// Chama o núcleo 'core' pela API legada: framebuffer 'ssd' na geometria de ssd1306_i2c.h,
+// com as regiões sujas do painel padrão
+#define ssd1306_legacy(core, ssd, ...) \
+    core((ssd), ssd1306_width, ssd1306_height, ssd1306_dirty_of(&ssd1306_default_display), __VA_ARGS__)
+
+// Amplia a faixa suja das páginas [page_0, page_1] para incluir as colunas [x_0, x_1]
+static inline void ssd1306_dirty_span(struct dirty_region *dirty, int x_0, int x_1, int page_0, int page_1) {
+    if (!dirty) {
+        return;
+    }
+    for (int page = page_0; page <= page_1; page++) {
+        if (x_0 < dirty->min_column[page]) {
+            dirty->min_column[page] = x_0;
+        }
+        if (x_1 > dirty->max_column[page]) {
+            dirty->max_column[page] = x_1;
+        }
+    }
+}
+
+// Marca o retângulo de pixels (x_0, y_0)-(x_1, y_1), recortado a um painel columns x rows
+static inline void ssd1306_dirty_rect(struct dirty_region *dirty, int columns, int rows, int x_0, int y_0, int x_1, int y_1) {
+    if (x_0 < 0) x_0 = 0;
+    if (y_0 < 0) y_0 = 0;
+    if (x_1 > columns - 1) x_1 = columns - 1;
+    if (y_1 > rows - 1) y_1 = rows - 1;
+    if (x_0 > x_1 || y_0 > y_1) {
+        return;
+    }
+
+    ssd1306_dirty_span(dirty, x_0, x_1, y_0 / ssd1306_page_height, y_1 / ssd1306_page_height);
+}
+
+#endif
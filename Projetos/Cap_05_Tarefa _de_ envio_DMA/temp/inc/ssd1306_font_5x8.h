@@ -0,0 +1,447 @@
+// Fonte 5x8 gerada para o driver SSD1306: ASCII imprimível (0x20-0x7E) e Latin-1 (0xA0-0xFF)
+// Cada glyph tem 5 colunas verticais (bit menos significativo em cima); a linha 7 fica abaixo
+// da linha de base e só é usada pela cedilha
+
+// Código Latin-1 -> número do glyph. Códigos sem glyph apontam para '?', então a busca não tem desvios
+static const uint8_t font_5x8_index[256] = {
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,
+     16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+     32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,
+     48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,
+     64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,
+     80,  81,  82,  83,  84,  85,  86,  87,  88,  89,  90,  91,  92,  93,  94,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,  31,
+     95,  96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110,
+    111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126,
+    127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142,
+    143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158,
+    159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174,
+    175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190,
+};
+
+// Glyphs monoespaçados, 5 bytes cada, na ordem dos números do índice
+static const uint8_t font_5x8_glyphs[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, // espaço
+    0x00, 0x00, 0x5f, 0x00, 0x00, // !
+    0x00, 0x07, 0x00, 0x07, 0x00, // "
+    0x14, 0x7f, 0x14, 0x7f, 0x14, // #
+    0x24, 0x2a, 0x7f, 0x2a, 0x12, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, // %
+    0x36, 0x49, 0x55, 0x22, 0x50, // &
+    0x00, 0x05, 0x03, 0x00, 0x00, // '
+    0x00, 0x1c, 0x22, 0x41, 0x00, // (
+    0x00, 0x41, 0x22, 0x1c, 0x00, // )
+    0x08, 0x2a, 0x1c, 0x2a, 0x08, // *
+    0x08, 0x08, 0x3e, 0x08, 0x08, // +
+    0x00, 0x50, 0x30, 0x00, 0x00, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, // -
+    0x00, 0x60, 0x60, 0x00, 0x00, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, // /
+    0x3e, 0x51, 0x49, 0x45, 0x3e, // 0
+    0x00, 0x42, 0x7f, 0x40, 0x00, // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, // 2
+    0x21, 0x41, 0x45, 0x4b, 0x31, // 3
+    0x18, 0x14, 0x12, 0x7f, 0x10, // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, // 5
+    0x3c, 0x4a, 0x49, 0x49, 0x30, // 6
+    0x01, 0x71, 0x09, 0x05, 0x03, // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, // 8
+    0x06, 0x49, 0x49, 0x29, 0x1e, // 9
+    0x00, 0x36, 0x36, 0x00, 0x00, // :
+    0x00, 0x56, 0x36, 0x00, 0x00, // ;
+    0x08, 0x14, 0x22, 0x41, 0x00, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, // =
+    0x00, 0x41, 0x22, 0x14, 0x08, // >
+    0x02, 0x01, 0x51, 0x09, 0x06, // ?
+    0x32, 0x49, 0x79, 0x41, 0x3e, // @
+    0x7e, 0x11, 0x11, 0x11, 0x7e, // A
+    0x7f, 0x49, 0x49, 0x49, 0x36, // B
+    0x3e, 0x41, 0x41, 0x41, 0x22, // C
+    0x7f, 0x41, 0x41, 0x22, 0x1c, // D
+    0x7f, 0x49, 0x49, 0x49, 0x41, // E
+    0x7f, 0x09, 0x09, 0x09, 0x01, // F
+    0x3e, 0x41, 0x49, 0x49, 0x7a, // G
+    0x7f, 0x08, 0x08, 0x08, 0x7f, // H
+    0x00, 0x41, 0x7f, 0x41, 0x00, // I
+    0x20, 0x40, 0x41, 0x3f, 0x01, // J
+    0x7f, 0x08, 0x14, 0x22, 0x41, // K
+    0x7f, 0x40, 0x40, 0x40, 0x40, // L
+    0x7f, 0x02, 0x0c, 0x02, 0x7f, // M
+    0x7f, 0x04, 0x08, 0x10, 0x7f, // N
+    0x3e, 0x41, 0x41, 0x41, 0x3e, // O
+    0x7f, 0x09, 0x09, 0x09, 0x06, // P
+    0x3e, 0x41, 0x51, 0x21, 0x5e, // Q
+    0x7f, 0x09, 0x19, 0x29, 0x46, // R
+    0x46, 0x49, 0x49, 0x49, 0x31, // S
+    0x01, 0x01, 0x7f, 0x01, 0x01, // T
+    0x3f, 0x40, 0x40, 0x40, 0x3f, // U
+    0x1f, 0x20, 0x40, 0x20, 0x1f, // V
+    0x3f, 0x40, 0x38, 0x40, 0x3f, // W
+    0x63, 0x14, 0x08, 0x14, 0x63, // X
+    0x07, 0x08, 0x70, 0x08, 0x07, // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, // Z
+    0x00, 0x7f, 0x41, 0x41, 0x00, // [
+    0x02, 0x04, 0x08, 0x10, 0x20, // barra invertida
+    0x00, 0x41, 0x41, 0x7f, 0x00, // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, // _
+    0x00, 0x01, 0x02, 0x04, 0x00, // `
+    0x20, 0x54, 0x54, 0x54, 0x78, // a
+    0x7f, 0x48, 0x44, 0x44, 0x38, // b
+    0x38, 0x44, 0x44, 0x44, 0x20, // c
+    0x38, 0x44, 0x44, 0x48, 0x7f, // d
+    0x38, 0x54, 0x54, 0x54, 0x18, // e
+    0x08, 0x7e, 0x09, 0x01, 0x02, // f
+    0x0c, 0x52, 0x52, 0x52, 0x3e, // g
+    0x7f, 0x08, 0x04, 0x04, 0x78, // h
+    0x00, 0x44, 0x7d, 0x40, 0x00, // i
+    0x20, 0x40, 0x44, 0x3d, 0x00, // j
+    0x7f, 0x10, 0x28, 0x44, 0x00, // k
+    0x00, 0x41, 0x7f, 0x40, 0x00, // l
+    0x7c, 0x04, 0x18, 0x04, 0x78, // m
+    0x7c, 0x08, 0x04, 0x04, 0x78, // n
+    0x38, 0x44, 0x44, 0x44, 0x38, // o
+    0x7c, 0x14, 0x14, 0x14, 0x08, // p
+    0x08, 0x14, 0x14, 0x18, 0x7c, // q
+    0x7c, 0x08, 0x04, 0x04, 0x08, // r
+    0x48, 0x54, 0x54, 0x54, 0x20, // s
+    0x04, 0x3f, 0x44, 0x40, 0x20, // t
+    0x3c, 0x40, 0x40, 0x20, 0x7c, // u
+    0x1c, 0x20, 0x40, 0x20, 0x1c, // v
+    0x3c, 0x40, 0x30, 0x40, 0x3c, // w
+    0x44, 0x28, 0x10, 0x28, 0x44, // x
+    0x0c, 0x50, 0x50, 0x50, 0x3c, // y
+    0x44, 0x64, 0x54, 0x4c, 0x44, // z
+    0x00, 0x08, 0x36, 0x41, 0x00, // {
+    0x00, 0x00, 0x7f, 0x00, 0x00, // |
+    0x00, 0x41, 0x36, 0x08, 0x00, // }
+    0x08, 0x04, 0x08, 0x10, 0x08, // ~
+    0x00, 0x00, 0x00, 0x00, 0x00, // espaço sem quebra
+    0x00, 0x00, 0x7d, 0x00, 0x00, // ¡
+    0x18, 0x24, 0x7e, 0x24, 0x24, // ¢
+    0x48, 0x7e, 0x49, 0x41, 0x62, // £
+    0x22, 0x1c, 0x14, 0x1c, 0x22, // ¤
+    0x15, 0x16, 0x7c, 0x16, 0x15, // ¥
+    0x00, 0x00, 0x77, 0x00, 0x00, // ¦
+    0x4a, 0x55, 0x55, 0x29, 0x00, // §
+    0x00, 0x01, 0x00, 0x01, 0x00, // ¨
+    0x3e, 0x41, 0x5d, 0x55, 0x3e, // ©
+    0x48, 0x55, 0x55, 0x5e, 0x00, // ª
+    0x08, 0x14, 0x2a, 0x14, 0x22, // «
+    0x04, 0x04, 0x04, 0x04, 0x1c, // ¬
+    0x00, 0x08, 0x08, 0x08, 0x00, // hífen condicional
+    0x3e, 0x41, 0x5d, 0x4d, 0x36, // ®
+    0x01, 0x01, 0x01, 0x01, 0x01, // ¯
+    0x06, 0x09, 0x09, 0x06, 0x00, // °
+    0x44, 0x44, 0x5f, 0x44, 0x44, // ±
+    0x00, 0x19, 0x15, 0x12, 0x00, // ²
+    0x00, 0x11, 0x15, 0x1f, 0x00, // ³
+    0x00, 0x00, 0x02, 0x01, 0x00, // ´
+    0x7c, 0x20, 0x20, 0x1c, 0x20, // µ
+    0x06, 0x0f, 0x7f, 0x01, 0x7f, // ¶
+    0x00, 0x00, 0x08, 0x00, 0x00, // ·
+    0x00, 0x80, 0xa0, 0x40, 0x00, // ¸
+    0x00, 0x12, 0x1f, 0x10, 0x00, // ¹
+    0x4e, 0x51, 0x51, 0x4e, 0x00, // º
+    0x22, 0x14, 0x2a, 0x14, 0x08, // »
+    0x27, 0x10, 0x28, 0x74, 0x22, // ¼
+    0x27, 0x10, 0x08, 0x54, 0x72, // ½
+    0x25, 0x17, 0x28, 0x74, 0x22, // ¾
+    0x30, 0x48, 0x45, 0x40, 0x20, // ¿
+    0x78, 0x15, 0x16, 0x14, 0x78, // À
+    0x78, 0x14, 0x16, 0x15, 0x78, // Á
+    0x78, 0x16, 0x15, 0x16, 0x78, // Â
+    0x7a, 0x15, 0x15, 0x16, 0x79, // Ã
+    0x78, 0x15, 0x14, 0x15, 0x78, // Ä
+    0x78, 0x14, 0x17, 0x17, 0x78, // Å
+    0x7e, 0x09, 0x7f, 0x49, 0x41, // Æ
+    0x3e, 0xc1, 0xc1, 0x41, 0x22, // Ç
+    0x7c, 0x55, 0x56, 0x54, 0x44, // È
+    0x7c, 0x54, 0x56, 0x55, 0x44, // É
+    0x7c, 0x56, 0x55, 0x56, 0x44, // Ê
+    0x7c, 0x55, 0x54, 0x55, 0x44, // Ë
+    0x00, 0x45, 0x7e, 0x44, 0x00, // Ì
+    0x00, 0x44, 0x7e, 0x45, 0x00, // Í
+    0x00, 0x46, 0x7d, 0x46, 0x00, // Î
+    0x00, 0x45, 0x7c, 0x45, 0x00, // Ï
+    0x7f, 0x49, 0x49, 0x22, 0x1c, // Ð
+    0x7e, 0x09, 0x11, 0x22, 0x7d, // Ñ
+    0x38, 0x45, 0x46, 0x44, 0x38, // Ò
+    0x38, 0x44, 0x46, 0x45, 0x38, // Ó
+    0x38, 0x46, 0x45, 0x46, 0x38, // Ô
+    0x3a, 0x45, 0x45, 0x46, 0x39, // Õ
+    0x38, 0x45, 0x44, 0x45, 0x38, // Ö
+    0x22, 0x14, 0x08, 0x14, 0x22, // ×
+    0x3e, 0x61, 0x5d, 0x43, 0x3e, // Ø
+    0x3c, 0x41, 0x42, 0x40, 0x3c, // Ù
+    0x3c, 0x40, 0x42, 0x41, 0x3c, // Ú
+    0x3c, 0x42, 0x41, 0x42, 0x3c, // Û
+    0x3c, 0x41, 0x40, 0x41, 0x3c, // Ü
+    0x04, 0x08, 0x72, 0x09, 0x04, // Ý
+    0x7f, 0x12, 0x12, 0x12, 0x0c, // Þ
+    0x7e, 0x01, 0x49, 0x76, 0x00, // ß
+    0x20, 0x55, 0x56, 0x54, 0x78, // à
+    0x20, 0x54, 0x56, 0x55, 0x78, // á
+    0x20, 0x56, 0x55, 0x56, 0x78, // â
+    0x22, 0x55, 0x55, 0x56, 0x79, // ã
+    0x20, 0x55, 0x54, 0x55, 0x78, // ä
+    0x20, 0x54, 0x57, 0x57, 0x78, // å
+    0x24, 0x54, 0x38, 0x54, 0x58, // æ
+    0x38, 0xc4, 0xc4, 0x44, 0x20, // ç
+    0x38, 0x55, 0x56, 0x54, 0x18, // è
+    0x38, 0x54, 0x56, 0x55, 0x18, // é
+    0x38, 0x56, 0x55, 0x56, 0x18, // ê
+    0x38, 0x55, 0x54, 0x55, 0x18, // ë
+    0x00, 0x45, 0x7e, 0x40, 0x00, // ì
+    0x00, 0x44, 0x7e, 0x41, 0x00, // í
+    0x00, 0x46, 0x7d, 0x42, 0x00, // î
+    0x00, 0x45, 0x7c, 0x41, 0x00, // ï
+    0x20, 0x55, 0x52, 0x55, 0x38, // ð
+    0x7e, 0x09, 0x05, 0x06, 0x79, // ñ
+    0x38, 0x45, 0x46, 0x44, 0x38, // ò
+    0x38, 0x44, 0x46, 0x45, 0x38, // ó
+    0x38, 0x46, 0x45, 0x46, 0x38, // ô
+    0x3a, 0x45, 0x45, 0x46, 0x39, // õ
+    0x38, 0x45, 0x44, 0x45, 0x38, // ö
+    0x08, 0x08, 0x2a, 0x08, 0x08, // ÷
+    0x38, 0x64, 0x54, 0x4c, 0x38, // ø
+    0x3c, 0x41, 0x42, 0x20, 0x7c, // ù
+    0x3c, 0x40, 0x42, 0x21, 0x7c, // ú
+    0x3c, 0x42, 0x41, 0x22, 0x7c, // û
+    0x3c, 0x41, 0x40, 0x21, 0x7c, // ü
+    0x0c, 0x50, 0x52, 0x51, 0x3c, // ý
+    0x7f, 0x14, 0x14, 0x14, 0x08, // þ
+    0x0c, 0x51, 0x50, 0x51, 0x3c, // ÿ
+};
+
+// Versão proporcional: colunas vazias nas bordas removidas
+static const uint8_t font_5x8_prop_glyphs[] = {
+    0x00, 0x00, // espaço
+    0x5f, // !
+    0x07, 0x00, 0x07, // "
+    0x14, 0x7f, 0x14, 0x7f, 0x14, // #
+    0x24, 0x2a, 0x7f, 0x2a, 0x12, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, // %
+    0x36, 0x49, 0x55, 0x22, 0x50, // &
+    0x05, 0x03, // '
+    0x1c, 0x22, 0x41, // (
+    0x41, 0x22, 0x1c, // )
+    0x08, 0x2a, 0x1c, 0x2a, 0x08, // *
+    0x08, 0x08, 0x3e, 0x08, 0x08, // +
+    0x50, 0x30, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, // -
+    0x60, 0x60, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, // /
+    0x3e, 0x51, 0x49, 0x45, 0x3e, // 0
+    0x42, 0x7f, 0x40, // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, // 2
+    0x21, 0x41, 0x45, 0x4b, 0x31, // 3
+    0x18, 0x14, 0x12, 0x7f, 0x10, // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, // 5
+    0x3c, 0x4a, 0x49, 0x49, 0x30, // 6
+    0x01, 0x71, 0x09, 0x05, 0x03, // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, // 8
+    0x06, 0x49, 0x49, 0x29, 0x1e, // 9
+    0x36, 0x36, // :
+    0x56, 0x36, // ;
+    0x08, 0x14, 0x22, 0x41, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, // =
+    0x41, 0x22, 0x14, 0x08, // >
+    0x02, 0x01, 0x51, 0x09, 0x06, // ?
+    0x32, 0x49, 0x79, 0x41, 0x3e, // @
+    0x7e, 0x11, 0x11, 0x11, 0x7e, // A
+    0x7f, 0x49, 0x49, 0x49, 0x36, // B
+    0x3e, 0x41, 0x41, 0x41, 0x22, // C
+    0x7f, 0x41, 0x41, 0x22, 0x1c, // D
+    0x7f, 0x49, 0x49, 0x49, 0x41, // E
+    0x7f, 0x09, 0x09, 0x09, 0x01, // F
+    0x3e, 0x41, 0x49, 0x49, 0x7a, // G
+    0x7f, 0x08, 0x08, 0x08, 0x7f, // H
+    0x41, 0x7f, 0x41, // I
+    0x20, 0x40, 0x41, 0x3f, 0x01, // J
+    0x7f, 0x08, 0x14, 0x22, 0x41, // K
+    0x7f, 0x40, 0x40, 0x40, 0x40, // L
+    0x7f, 0x02, 0x0c, 0x02, 0x7f, // M
+    0x7f, 0x04, 0x08, 0x10, 0x7f, // N
+    0x3e, 0x41, 0x41, 0x41, 0x3e, // O
+    0x7f, 0x09, 0x09, 0x09, 0x06, // P
+    0x3e, 0x41, 0x51, 0x21, 0x5e, // Q
+    0x7f, 0x09, 0x19, 0x29, 0x46, // R
+    0x46, 0x49, 0x49, 0x49, 0x31, // S
+    0x01, 0x01, 0x7f, 0x01, 0x01, // T
+    0x3f, 0x40, 0x40, 0x40, 0x3f, // U
+    0x1f, 0x20, 0x40, 0x20, 0x1f, // V
+    0x3f, 0x40, 0x38, 0x40, 0x3f, // W
+    0x63, 0x14, 0x08, 0x14, 0x63, // X
+    0x07, 0x08, 0x70, 0x08, 0x07, // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, // Z
+    0x7f, 0x41, 0x41, // [
+    0x02, 0x04, 0x08, 0x10, 0x20, // barra invertida
+    0x41, 0x41, 0x7f, // ]
+    0x04, 0x02, 0x01, 0x02, 0x04, // ^
+    0x40, 0x40, 0x40, 0x40, 0x40, // _
+    0x01, 0x02, 0x04, // `
+    0x20, 0x54, 0x54, 0x54, 0x78, // a
+    0x7f, 0x48, 0x44, 0x44, 0x38, // b
+    0x38, 0x44, 0x44, 0x44, 0x20, // c
+    0x38, 0x44, 0x44, 0x48, 0x7f, // d
+    0x38, 0x54, 0x54, 0x54, 0x18, // e
+    0x08, 0x7e, 0x09, 0x01, 0x02, // f
+    0x0c, 0x52, 0x52, 0x52, 0x3e, // g
+    0x7f, 0x08, 0x04, 0x04, 0x78, // h
+    0x44, 0x7d, 0x40, // i
+    0x20, 0x40, 0x44, 0x3d, // j
+    0x7f, 0x10, 0x28, 0x44, // k
+    0x41, 0x7f, 0x40, // l
+    0x7c, 0x04, 0x18, 0x04, 0x78, // m
+    0x7c, 0x08, 0x04, 0x04, 0x78, // n
+    0x38, 0x44, 0x44, 0x44, 0x38, // o
+    0x7c, 0x14, 0x14, 0x14, 0x08, // p
+    0x08, 0x14, 0x14, 0x18, 0x7c, // q
+    0x7c, 0x08, 0x04, 0x04, 0x08, // r
+    0x48, 0x54, 0x54, 0x54, 0x20, // s
+    0x04, 0x3f, 0x44, 0x40, 0x20, // t
+    0x3c, 0x40, 0x40, 0x20, 0x7c, // u
+    0x1c, 0x20, 0x40, 0x20, 0x1c, // v
+    0x3c, 0x40, 0x30, 0x40, 0x3c, // w
+    0x44, 0x28, 0x10, 0x28, 0x44, // x
+    0x0c, 0x50, 0x50, 0x50, 0x3c, // y
+    0x44, 0x64, 0x54, 0x4c, 0x44, // z
+    0x08, 0x36, 0x41, // {
+    0x7f, // |
+    0x41, 0x36, 0x08, // }
+    0x08, 0x04, 0x08, 0x10, 0x08, // ~
+    0x00, 0x00, // espaço sem quebra
+    0x7d, // ¡
+    0x18, 0x24, 0x7e, 0x24, 0x24, // ¢
+    0x48, 0x7e, 0x49, 0x41, 0x62, // £
+    0x22, 0x1c, 0x14, 0x1c, 0x22, // ¤
+    0x15, 0x16, 0x7c, 0x16, 0x15, // ¥
+    0x77, // ¦
+    0x4a, 0x55, 0x55, 0x29, // §
+    0x01, 0x00, 0x01, // ¨
+    0x3e, 0x41, 0x5d, 0x55, 0x3e, // ©
+    0x48, 0x55, 0x55, 0x5e, // ª
+    0x08, 0x14, 0x2a, 0x14, 0x22, // «
+    0x04, 0x04, 0x04, 0x04, 0x1c, // ¬
+    0x08, 0x08, 0x08, // hífen condicional
+    0x3e, 0x41, 0x5d, 0x4d, 0x36, // ®
+    0x01, 0x01, 0x01, 0x01, 0x01, // ¯
+    0x06, 0x09, 0x09, 0x06, // °
+    0x44, 0x44, 0x5f, 0x44, 0x44, // ±
+    0x19, 0x15, 0x12, // ²
+    0x11, 0x15, 0x1f, // ³
+    0x02, 0x01, // ´
+    0x7c, 0x20, 0x20, 0x1c, 0x20, // µ
+    0x06, 0x0f, 0x7f, 0x01, 0x7f, // ¶
+    0x08, // ·
+    0x80, 0xa0, 0x40, // ¸
+    0x12, 0x1f, 0x10, // ¹
+    0x4e, 0x51, 0x51, 0x4e, // º
+    0x22, 0x14, 0x2a, 0x14, 0x08, // »
+    0x27, 0x10, 0x28, 0x74, 0x22, // ¼
+    0x27, 0x10, 0x08, 0x54, 0x72, // ½
+    0x25, 0x17, 0x28, 0x74, 0x22, // ¾
+    0x30, 0x48, 0x45, 0x40, 0x20, // ¿
+    0x78, 0x15, 0x16, 0x14, 0x78, // À
+    0x78, 0x14, 0x16, 0x15, 0x78, // Á
+    0x78, 0x16, 0x15, 0x16, 0x78, // Â
+    0x7a, 0x15, 0x15, 0x16, 0x79, // Ã
+    0x78, 0x15, 0x14, 0x15, 0x78, // Ä
+    0x78, 0x14, 0x17, 0x17, 0x78, // Å
+    0x7e, 0x09, 0x7f, 0x49, 0x41, // Æ
+    0x3e, 0xc1, 0xc1, 0x41, 0x22, // Ç
+    0x7c, 0x55, 0x56, 0x54, 0x44, // È
+    0x7c, 0x54, 0x56, 0x55, 0x44, // É
+    0x7c, 0x56, 0x55, 0x56, 0x44, // Ê
+    0x7c, 0x55, 0x54, 0x55, 0x44, // Ë
+    0x45, 0x7e, 0x44, // Ì
+    0x44, 0x7e, 0x45, // Í
+    0x46, 0x7d, 0x46, // Î
+    0x45, 0x7c, 0x45, // Ï
+    0x7f, 0x49, 0x49, 0x22, 0x1c, // Ð
+    0x7e, 0x09, 0x11, 0x22, 0x7d, // Ñ
+    0x38, 0x45, 0x46, 0x44, 0x38, // Ò
+    0x38, 0x44, 0x46, 0x45, 0x38, // Ó
+    0x38, 0x46, 0x45, 0x46, 0x38, // Ô
+    0x3a, 0x45, 0x45, 0x46, 0x39, // Õ
+    0x38, 0x45, 0x44, 0x45, 0x38, // Ö
+    0x22, 0x14, 0x08, 0x14, 0x22, // ×
+    0x3e, 0x61, 0x5d, 0x43, 0x3e, // Ø
+    0x3c, 0x41, 0x42, 0x40, 0x3c, // Ù
+    0x3c, 0x40, 0x42, 0x41, 0x3c, // Ú
+    0x3c, 0x42, 0x41, 0x42, 0x3c, // Û
+    0x3c, 0x41, 0x40, 0x41, 0x3c, // Ü
+    0x04, 0x08, 0x72, 0x09, 0x04, // Ý
+    0x7f, 0x12, 0x12, 0x12, 0x0c, // Þ
+    0x7e, 0x01, 0x49, 0x76, // ß
+    0x20, 0x55, 0x56, 0x54, 0x78, // à
+    0x20, 0x54, 0x56, 0x55, 0x78, // á
+    0x20, 0x56, 0x55, 0x56, 0x78, // â
+    0x22, 0x55, 0x55, 0x56, 0x79, // ã
+    0x20, 0x55, 0x54, 0x55, 0x78, // ä
+    0x20, 0x54, 0x57, 0x57, 0x78, // å
+    0x24, 0x54, 0x38, 0x54, 0x58, // æ
+    0x38, 0xc4, 0xc4, 0x44, 0x20, // ç
+    0x38, 0x55, 0x56, 0x54, 0x18, // è
+    0x38, 0x54, 0x56, 0x55, 0x18, // é
+    0x38, 0x56, 0x55, 0x56, 0x18, // ê
+    0x38, 0x55, 0x54, 0x55, 0x18, // ë
+    0x45, 0x7e, 0x40, // ì
+    0x44, 0x7e, 0x41, // í
+    0x46, 0x7d, 0x42, // î
+    0x45, 0x7c, 0x41, // ï
+    0x20, 0x55, 0x52, 0x55, 0x38, // ð
+    0x7e, 0x09, 0x05, 0x06, 0x79, // ñ
+    0x38, 0x45, 0x46, 0x44, 0x38, // ò
+    0x38, 0x44, 0x46, 0x45, 0x38, // ó
+    0x38, 0x46, 0x45, 0x46, 0x38, // ô
+    0x3a, 0x45, 0x45, 0x46, 0x39, // õ
+    0x38, 0x45, 0x44, 0x45, 0x38, // ö
+    0x08, 0x08, 0x2a, 0x08, 0x08, // ÷
+    0x38, 0x64, 0x54, 0x4c, 0x38, // ø
+    0x3c, 0x41, 0x42, 0x20, 0x7c, // ù
+    0x3c, 0x40, 0x42, 0x21, 0x7c, // ú
+    0x3c, 0x42, 0x41, 0x22, 0x7c, // û
+    0x3c, 0x41, 0x40, 0x21, 0x7c, // ü
+    0x0c, 0x50, 0x52, 0x51, 0x3c, // ý
+    0x7f, 0x14, 0x14, 0x14, 0x08, // þ
+    0x0c, 0x51, 0x50, 0x51, 0x3c, // ÿ
+};
+
+static const uint16_t font_5x8_prop_offsets[] = {
+      0,   2,   3,   6,  11,  16,  21,  26,  28,  31,  34,  39,
+     44,  46,  51,  53,  58,  63,  66,  71,  76,  81,  86,  91,
+     96, 101, 106, 108, 110, 114, 119, 123, 128, 133, 138, 143,
+    148, 153, 158, 163, 168, 173, 176, 181, 186, 191, 196, 201,
+    206, 211, 216, 221, 226, 231, 236, 241, 246, 251, 256, 261,
+    264, 269, 272, 277, 282, 285, 290, 295, 300, 305, 310, 315,
+    320, 325, 328, 332, 336, 339, 344, 349, 354, 359, 364, 369,
+    374, 379, 384, 389, 394, 399, 404, 409, 412, 413, 416, 421,
+    423, 424, 429, 434, 439, 444, 445, 449, 452, 457, 461, 466,
+    471, 474, 479, 484, 488, 493, 496, 499, 501, 506, 511, 512,
+    515, 518, 522, 527, 532, 537, 542, 547, 552, 557, 562, 567,
+    572, 577, 582, 587, 592, 597, 602, 607, 610, 613, 616, 619,
+    624, 629, 634, 639, 644, 649, 654, 659, 664, 669, 674, 679,
+    684, 689, 694, 698, 703, 708, 713, 718, 723, 728, 733, 738,
+    743, 748, 753, 758, 761, 764, 767, 770, 775, 780, 785, 790,
+    795, 800, 805, 810, 815, 820, 825, 830, 835, 840, 845,
+};
+
+static const uint8_t font_5x8_prop_widths[] = {
+    2, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5, 2,
+    1, 5, 5, 5, 5, 1, 4, 3, 5, 4, 5, 5, 3, 5, 5, 4,
+    5, 3, 3, 2, 5, 5, 1, 3, 3, 4, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 3, 3, 3, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 3, 3, 3, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+};
@@ -0,0 +1,266 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306_core.h"
+
+// Primitivas gráficas que operam em bytes (e palavras de 32 bits) do framebuffer em vez de
+// pixel a pixel. No layout de páginas, uma coluna de 8 linhas é um único byte: spans verticais
+// viram uma máscara por página e retângulos viram a mesma máscara aplicada a colunas seguidas
+
+// Palavra de 32 bits que pode apelidar o framebuffer de bytes
+typedef uint32_t __attribute__((may_alias)) ssd1306_word_t;
+
+// Máscara dos bits das linhas [y_0, y_1] dentro da página 'page' (0 se não houver interseção)
+static inline uint8_t ssd1306_page_mask(int page, int y_0, int y_1) {
+    int top = page * 8;
+    int from = y_0 > top ? y_0 - top : 0;
+    int to = y_1 < top + 7 ? y_1 - top : 7;
+
+    if (from > to) {
+        return 0;
+    }
+    return (uint8_t) ((0xFFu << from) & (0xFFu >> (7 - to)));
+}
+
+// Aplica a máscara a 'count' bytes seguidos. O miolo alinhado é processado de 4 em 4 bytes,
+// pois o Cortex-M0+ não aceita acesso de palavra desalinhado
+static void ssd1306_apply_span(uint8_t *bytes, int count, uint8_t mask, ssd1306_draw_mode_t mode) {
+    if (mask == 0xFF && mode != ssd1306_mode_invert) {
+        memset(bytes, mode == ssd1306_mode_set ? 0xFF : 0x00, count);
+        return;
+    }
+
+    while (count > 0 && ((uintptr_t) bytes & 3)) {
+        if (mode == ssd1306_mode_set) *bytes |= mask;
+        else if (mode == ssd1306_mode_clear) *bytes &= ~mask;
+        else *bytes ^= mask;
+        bytes++;
+        count--;
+    }
+
+    uint32_t mask_32 = mask * 0x01010101u;
+    ssd1306_word_t *words = (ssd1306_word_t *) bytes;
+    for (; count >= 4; count -= 4) {
+        if (mode == ssd1306_mode_set) *words |= mask_32;
+        else if (mode == ssd1306_mode_clear) *words &= ~mask_32;
+        else *words ^= mask_32;
+        words++;
+    }
+
+    bytes = (uint8_t *) words;
+    while (count-- > 0) {
+        if (mode == ssd1306_mode_set) *bytes |= mask;
+        else if (mode == ssd1306_mode_clear) *bytes &= ~mask;
+        else *bytes ^= mask;
+        bytes++;
+    }
+}
+
+// Pixel sem divisão, módulo nem assert; coordenadas fora da tela são ignoradas
+static inline void ssd1306_fast_pixel(uint8_t *ssd, int columns, int rows, int x, int y, ssd1306_draw_mode_t mode) {
+    if ((unsigned) x >= (unsigned) columns || (unsigned) y >= (unsigned) rows) {
+        return;
+    }
+
+    uint8_t *byte = ssd + (y >> 3) * columns + x;
+    uint8_t bit = 1u << (y & 7);
+    if (mode == ssd1306_mode_set) *byte |= bit;
+    else if (mode == ssd1306_mode_clear) *byte &= ~bit;
+    else *byte ^= bit;
+}
+
+// Preenche o retângulo (x, y, width, height), recortado à tela
+ssd1306_core void ssd1306_fill_rect_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    int x_0 = x < 0 ? 0 : x;
+    int y_0 = y < 0 ? 0 : y;
+    int x_1 = x + width - 1 < columns - 1 ? x + width - 1 : columns - 1;
+    int y_1 = y + height - 1 < rows - 1 ? y + height - 1 : rows - 1;
+
+    if (x_0 > x_1 || y_0 > y_1) {
+        return;
+    }
+
+    for (int page = y_0 >> 3; page <= y_1 >> 3; page++) {
+        ssd1306_apply_span(ssd + page * columns + x_0, x_1 - x_0 + 1, ssd1306_page_mask(page, y_0, y_1), mode);
+    }
+    ssd1306_dirty_span(dirty, x_0, x_1, y_0 >> 3, y_1 >> 3);
+}
+
+// Linha horizontal de x_0 a x_1 (inclusive) na linha y
+ssd1306_core void ssd1306_draw_hline_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x_0, int x_1, int y, ssd1306_draw_mode_t mode) {
+    if (x_0 > x_1) {
+        int t = x_0; x_0 = x_1; x_1 = t;
+    }
+    ssd1306_fill_rect_core(ssd, columns, rows, dirty, x_0, y, x_1 - x_0 + 1, 1, mode);
+}
+
+// Linha vertical de y_0 a y_1 (inclusive) na coluna x: um byte por página
+ssd1306_core void ssd1306_draw_vline_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y_0, int y_1, ssd1306_draw_mode_t mode) {
+    if (y_0 > y_1) {
+        int t = y_0; y_0 = y_1; y_1 = t;
+    }
+    ssd1306_fill_rect_core(ssd, columns, rows, dirty, x, y_0, 1, y_1 - y_0 + 1, mode);
+}
+
+// Contorno de retângulo
+ssd1306_core void ssd1306_draw_rect_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    ssd1306_draw_hline_core(ssd, columns, rows, dirty, x, x + width - 1, y, mode);
+    if (height > 1) {
+        ssd1306_draw_hline_core(ssd, columns, rows, dirty, x, x + width - 1, y + height - 1, mode);
+    }
+    if (height > 2) {
+        ssd1306_draw_vline_core(ssd, columns, rows, dirty, x, y + 1, y + height - 2, mode);
+        if (width > 1) {
+            ssd1306_draw_vline_core(ssd, columns, rows, dirty, x + width - 1, y + 1, y + height - 2, mode);
+        }
+    }
+}
+
+// Os quatro pontos simétricos (±dx, ±dy), sem repetir pontos (importante no modo XOR)
+static inline void ssd1306_plot_4(uint8_t *ssd, int columns, int rows, int x_c, int y_c, int dx, int dy, ssd1306_draw_mode_t mode) {
+    ssd1306_fast_pixel(ssd, columns, rows, x_c + dx, y_c + dy, mode);
+    if (dx != 0) {
+        ssd1306_fast_pixel(ssd, columns, rows, x_c - dx, y_c + dy, mode);
+    }
+    if (dy != 0) {
+        ssd1306_fast_pixel(ssd, columns, rows, x_c + dx, y_c - dy, mode);
+        if (dx != 0) {
+            ssd1306_fast_pixel(ssd, columns, rows, x_c - dx, y_c - dy, mode);
+        }
+    }
+}
+
+// Contorno de círculo (algoritmo do ponto médio), com pixels rápidos
+ssd1306_core void ssd1306_draw_circle_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    if (radius < 0) {
+        return;
+    }
+
+    int x = radius, y = 0;
+    int error = 1 - radius;
+
+    while (x >= y) {
+        ssd1306_plot_4(ssd, columns, rows, x_c, y_c, x, y, mode);
+        if (x != y) {
+            ssd1306_plot_4(ssd, columns, rows, x_c, y_c, y, x, mode);
+        }
+
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        }
+        else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+    ssd1306_dirty_rect(dirty, columns, rows, x_c - radius, y_c - radius, x_c + radius, y_c + radius);
+}
+
+// Coluna ±dx do círculo preenchido, com meia-altura 'half_height'
+static inline void ssd1306_circle_span(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x_c, int y_c, int dx, int half_height, ssd1306_draw_mode_t mode) {
+    ssd1306_draw_vline_core(ssd, columns, rows, dirty, x_c + dx, y_c - half_height, y_c + half_height, mode);
+    if (dx != 0) {
+        ssd1306_draw_vline_core(ssd, columns, rows, dirty, x_c - dx, y_c - half_height, y_c + half_height, mode);
+    }
+}
+
+// Círculo preenchido: cada coluna do círculo é um span vertical (uma máscara por página),
+// desenhado direto do laço do ponto médio, sem memória proporcional ao raio. A coluna y recebe
+// a meia-altura x no seu único passo; a coluna x, a maior meia-altura y, no passo em que x vai
+// mudar. Com x == y as duas são a mesma coluna e ela sai uma vez só (importante no modo XOR)
+ssd1306_core void ssd1306_fill_circle_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    if (radius < 0) {
+        return;
+    }
+
+    int x = radius, y = 0;
+    int error = 1 - radius;
+
+    while (x >= y) {
+        ssd1306_circle_span(ssd, columns, rows, dirty, x_c, y_c, y, x, mode);
+
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        }
+        else {
+            if (x != y - 1) {
+                ssd1306_circle_span(ssd, columns, rows, dirty, x_c, y_c, x, y - 1, mode);
+            }
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+}
+
+// API legada: framebuffer na geometria de ssd1306_i2c.h, regiões sujas do painel padrão
+void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_fill_rect_core, ssd, x, y, width, height, mode);
+}
+
+void ssd1306_draw_hline(uint8_t *ssd, int x_0, int x_1, int y, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_draw_hline_core, ssd, x_0, x_1, y, mode);
+}
+
+void ssd1306_draw_vline(uint8_t *ssd, int x, int y_0, int y_1, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_draw_vline_core, ssd, x, y_0, y_1, mode);
+}
+
+void ssd1306_draw_rect(uint8_t *ssd, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_draw_rect_core, ssd, x, y, width, height, mode);
+}
+
+// Apaga uma região
+void ssd1306_clear_region(uint8_t *ssd, int x, int y, int width, int height) {
+    ssd1306_legacy(ssd1306_fill_rect_core, ssd, x, y, width, height, ssd1306_mode_clear);
+}
+
+// Inverte (XOR) uma região, ex.: para destacar um item de menu
+void ssd1306_invert_region(uint8_t *ssd, int x, int y, int width, int height) {
+    ssd1306_legacy(ssd1306_fill_rect_core, ssd, x, y, width, height, ssd1306_mode_invert);
+}
+
+void ssd1306_draw_circle(uint8_t *ssd, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_draw_circle_core, ssd, x_c, y_c, radius, mode);
+}
+
+void ssd1306_fill_circle(uint8_t *ssd, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_legacy(ssd1306_fill_circle_core, ssd, x_c, y_c, radius, mode);
+}
+
+// Mesmas primitivas sobre o framebuffer de um contexto
+void ssd1306_display_fill_rect(ssd1306_t *display, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_fill_rect_core, x, y, width, height, mode);
+}
+
+void ssd1306_display_draw_hline(ssd1306_t *display, int x_0, int x_1, int y, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_draw_hline_core, x_0, x_1, y, mode);
+}
+
+void ssd1306_display_draw_vline(ssd1306_t *display, int x, int y_0, int y_1, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_draw_vline_core, x, y_0, y_1, mode);
+}
+
+void ssd1306_display_draw_rect(ssd1306_t *display, int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_draw_rect_core, x, y, width, height, mode);
+}
+
+void ssd1306_display_clear_region(ssd1306_t *display, int x, int y, int width, int height) {
+    ssd1306_dispatch(display, ssd1306_fill_rect_core, x, y, width, height, ssd1306_mode_clear);
+}
+
+void ssd1306_display_invert_region(ssd1306_t *display, int x, int y, int width, int height) {
+    ssd1306_dispatch(display, ssd1306_fill_rect_core, x, y, width, height, ssd1306_mode_invert);
+}
+
+void ssd1306_display_draw_circle(ssd1306_t *display, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_draw_circle_core, x_c, y_c, radius, mode);
+}
+
+void ssd1306_display_fill_circle(ssd1306_t *display, int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_dispatch(display, ssd1306_fill_circle_core, x_c, y_c, radius, mode);
+}
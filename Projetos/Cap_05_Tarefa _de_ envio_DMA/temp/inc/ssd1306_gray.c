@@ -0,0 +1,198 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+// Tons de cinza num painel de 1 bit por modulação temporal: cada pixel tem dois planos de bits e
+// os planos são enviados em rodízio (1, 0, 1), rápido o bastante para o olho integrar o brilho.
+// Cada quadro é a janela inteira de um plano, enviada por ssd1306_async_flush; como o DMA lê do
+// buffer de transmissão, desenhar nos planos durante um envio não corrompe o quadro em curso.
+// O quadro seguinte é disparado por um timer repetitivo: se o anterior ainda estiver no
+// barramento, o tick conta como atraso e o rodízio espera o próximo. O SSD1306 não expõe o
+// sincronismo da varredura, então a troca de plano no meio dela aparece como cintilação: quanto
+// mais quadros por segundo, menor ela (janelas pequenas e i2c a 1 MHz ajudam; 128x3 páginas a
+// 1 MHz dão ~280 quadros/s, ~95 ciclos de cinza por segundo).
+// Enquanto o rodízio roda, o envio assíncrono do painel padrão pertence a ele
+// (ssd1306_async_claim): o tick do timer é o único a usá-lo, e as chamadas ssd1306_async_* dos
+// outros contextos são recusadas até ssd1306_gray_stop
+
+// Plano enviado em cada fase: o plano 1 vale o dobro do plano 0
+static const uint8_t plane_schedule[ssd1306_gray_phases] = { 1, 0, 1 };
+
+// Cria a janela [x, x + width) x [page, page + pages) com todos os pixels no nível 0
+void ssd1306_gray_init(ssd1306_gray_t *gray, int x, int page, int width, int pages) {
+    assert(x >= 0 && width > 0 && x + width <= ssd1306_width);
+    assert(page >= 0 && pages > 0 && page + pages <= ssd1306_n_pages);
+
+    memset(gray, 0, sizeof(*gray));
+    for (int bit = 0; bit < 2; bit++) {
+        // Cada plano vira um painel 128x64 sem barramento, para desenhar com as primitivas de contexto
+        ssd1306_t *view = &gray->plane_view[bit];
+        gray->planes[bit].control = ssd1306_control_data;
+        view->width = ssd1306_width;
+        view->height = ssd1306_height;
+        view->pages = ssd1306_n_pages;
+        view->ram_buffer = &gray->planes[bit].control;
+        view->bufsize = sizeof(gray->planes[bit]);
+    }
+
+    gray->area = (struct render_area) { .start_column = x, .end_column = x + width - 1, .start_page = page, .end_page = page + pages - 1 };
+    calculate_render_area_buffer_length(&gray->area);
+}
+
+// Apaga os dois planos (nível 0 em toda a tela)
+void ssd1306_gray_clear(ssd1306_gray_t *gray) {
+    memset(gray->planes[0].data, 0, ssd1306_buffer_length);
+    memset(gray->planes[1].data, 0, ssd1306_buffer_length);
+}
+
+void ssd1306_gray_set_pixel(ssd1306_gray_t *gray, int x, int y, uint8_t level) {
+    for (int bit = 0; bit < 2; bit++) {
+        ssd1306_display_set_pixel(&gray->plane_view[bit], x, y, (level >> bit) & 1);
+    }
+}
+
+// Nível de um pixel (0 fora da tela)
+uint8_t ssd1306_gray_get_pixel(ssd1306_gray_t *gray, int x, int y) {
+    if (x < 0 || x >= ssd1306_width || y < 0 || y >= ssd1306_height) {
+        return 0;
+    }
+
+    int index = (y / ssd1306_page_height) * ssd1306_width + x;
+    int shift = y % ssd1306_page_height;
+    return ((gray->planes[0].data[index] >> shift) & 1) | (((gray->planes[1].data[index] >> shift) & 1) << 1);
+}
+
+void ssd1306_gray_fill_rect(ssd1306_gray_t *gray, int x, int y, int width, int height, uint8_t level) {
+    for (int bit = 0; bit < 2; bit++) {
+        ssd1306_display_fill_rect(&gray->plane_view[bit], x, y, width, height, (level >> bit) & 1 ? ssd1306_mode_set : ssd1306_mode_clear);
+    }
+}
+
+// Copia um bitmap de 1 bit (opaco, como ssd1306_display_draw_image): os pixels acesos ficam no
+// nível 'level' e o resto da área do bitmap no nível 0
+void ssd1306_gray_draw_image(ssd1306_gray_t *gray, int x, int y, const ssd1306_bitmap_t *bitmap, uint8_t level) {
+    for (int bit = 0; bit < 2; bit++) {
+        if ((level >> bit) & 1) {
+            ssd1306_display_draw_image(&gray->plane_view[bit], x, y, bitmap);
+        }
+        else {
+            ssd1306_display_clear_region(&gray->plane_view[bit], x, y, bitmap->width, bitmap->height);
+        }
+    }
+}
+
+// Texto opaco no nível 'level'; retorna a coluna logo após o texto
+int ssd1306_gray_draw_text(ssd1306_gray_t *gray, int x, int y, const char *text, const ssd1306_font_t *font, uint8_t level) {
+    int end = x + ssd1306_text_width(text, font);
+
+    for (int bit = 0; bit < 2; bit++) {
+        if ((level >> bit) & 1) {
+            ssd1306_display_draw_text(&gray->plane_view[bit], x, y, text, font);
+        }
+        else {
+            ssd1306_display_clear_region(&gray->plane_view[bit], x, y, end - x, font->height);
+        }
+    }
+    return end;
+}
+
+// Tempo teórico de um quadro no barramento, na velocidade atual do i2c do painel padrão:
+// pixels da janela, 2 bytes de controle, 6 de endereço e o byte de endereço i2c de cada transação
+uint32_t ssd1306_gray_frame_us(ssd1306_gray_t *gray) {
+    uint32_t bytes = gray->area.buffer_length + 10;
+    return (uint32_t) ((uint64_t) bytes * 9 * 1000000 / ssd1306_transport_baudrate(ssd1306_default_display.i2c_port));
+}
+
+// Envia o plano da fase atual e avança o rodízio (em andamento, como dono do envio)
+static void ssd1306_gray_send(ssd1306_gray_t *gray) {
+    uint8_t *data = gray->planes[plane_schedule[gray->phase]].data;
+
+    gray->phase = (gray->phase + 1) % ssd1306_gray_phases;
+    gray->bytes += gray->running ? ssd1306_async_flush_owned(gray, data, &gray->area) : ssd1306_async_flush(data, &gray->area);
+    gray->frames++;
+}
+
+// Tick do timer (contexto de interrupção)
+static bool ssd1306_gray_tick(repeating_timer_t *timer) {
+    ssd1306_gray_t *gray = timer->user_data;
+
+    if (ssd1306_async_busy_owned(gray)) {
+        gray->late++;
+    }
+    else {
+        ssd1306_gray_send(gray);
+    }
+    return true;
+}
+
+static void ssd1306_gray_reset_stats(ssd1306_gray_t *gray) {
+    gray->frames = 0;
+    gray->late = 0;
+    gray->bytes = 0;
+    gray->phase = 0;
+    gray->started_us = time_us_32();
+}
+
+// Inicia o rodízio com um quadro a cada 'period_us' (0 = o tempo de um quadro no barramento mais
+// 1/8 de folga). Requer ssd1306_async_init; não inicia se o envio já tiver outro dono
+void ssd1306_gray_start(ssd1306_gray_t *gray, uint32_t period_us) {
+    if (gray->running) {
+        return;
+    }
+    if (!ssd1306_async_claim(gray)) {
+        return;
+    }
+    if (period_us == 0) {
+        uint32_t frame_us = ssd1306_gray_frame_us(gray);
+        period_us = frame_us + frame_us / 8;
+    }
+
+    ssd1306_gray_reset_stats(gray);
+    gray->running = true;
+    ssd1306_gray_send(gray);
+
+    // Período negativo: intervalo entre os inícios das chamadas, não entre o fim de uma e o início da outra
+    add_repeating_timer_us(-(int64_t) period_us, ssd1306_gray_tick, gray, &gray->timer);
+}
+
+// Para o rodízio e deixa na janela a versão de 1 bit da imagem (níveis 2 e 3 acesos, o plano 1)
+void ssd1306_gray_stop(ssd1306_gray_t *gray) {
+    if (!gray->running) {
+        return;
+    }
+
+    cancel_repeating_timer(&gray->timer);
+    gray->running = false;
+    gray->stopped_us = time_us_32();
+    ssd1306_async_release(gray);
+
+    ssd1306_async_wait();
+    ssd1306_async_flush(gray->planes[1].data, &gray->area);
+    ssd1306_async_wait();
+}
+
+// Contadores desde o último início; com eles, quadros/s = frames * 1e6 / elapsed_us e ciclos de
+// cinza/s = quadros/s / ssd1306_gray_phases
+void ssd1306_gray_get_stats(ssd1306_gray_t *gray, struct ssd1306_gray_stats *out) {
+    out->frames = gray->frames;
+    out->late = gray->late;
+    out->bytes = gray->bytes;
+    out->elapsed_us = (gray->running ? time_us_32() : gray->stopped_us) - gray->started_us;
+    out->frame_us = ssd1306_gray_frame_us(gray);
+}
+
+// Teste de vazão máxima do driver: envia quadros sem pausa por 'duration_ms'. O quadro seguinte
+// é montado e enfileirado enquanto o atual está no barramento (os dois buffers de ssd1306_async),
+// então o i2c não fica ocioso entre quadros. Não pode ser usado com o rodízio em andamento
+void ssd1306_gray_benchmark(ssd1306_gray_t *gray, uint32_t duration_ms, struct ssd1306_gray_stats *out) {
+    assert(!gray->running);
+
+    ssd1306_gray_reset_stats(gray);
+    while (time_us_32() - gray->started_us < duration_ms * 1000) {
+        ssd1306_gray_send(gray);
+    }
+    ssd1306_async_wait();
+    gray->stopped_us = time_us_32();
+
+    ssd1306_gray_get_stats(gray, out);
+}
@@ -1,245 +1,537 @@
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-#include "hardware/i2c.h"
-#include "ssd1306_font.h"
-#include "ssd1306_i2c.h"
-
-// Calcular quanto do buffer será destinado à área de renderização
-void calculate_render_area_buffer_length(struct render_area *area) {
-    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
-}
-
-// Processo de escrita do i2c espera um byte de controle, seguido por dados
-void ssd1306_send_command(uint8_t command) {
-    uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
-}
-
-// Envia uma lista de comandos ao hardware
-void ssd1306_send_command_list(uint8_t *ssd, int number) {
-    for (int i = 0; i < number; i++) {
-        ssd1306_send_command(ssd[i]);
-    }
-}
-
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
-void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
-
-    free(temp_buffer);
-}
-
-// Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
-void ssd1306_init() {
-    uint8_t commands[] = {
-        ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
-        ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01, 
-        ssd1306_set_mux_ratio, ssd1306_height - 1,
-        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
-        0x00, ssd1306_set_common_pin_configuration,
-    
-#if ((ssd1306_width == 128) && (ssd1306_height == 32))
-    0x02,
-#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
-    0x12,
-#else
-    0x02,
-#endif
-        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
-        0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
-        0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
-        ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
-        ssd1306_set_display | 0x01,
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Cria a lista de comandos para configurar o scrolling
-void ssd1306_scroll(bool set) {
-    uint8_t commands[] = {
-        ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
-        0x00, 0xFF, ssd1306_set_scroll | (set ? 0x01 : 0)
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-}
-
-// Atualiza uma parte do display com uma área de renderização
-void render_on_display(uint8_t *ssd, struct render_area *area) {
-    uint8_t commands[] = {
-        ssd1306_set_column_address, area->start_column, area->end_column,
-        ssd1306_set_page_address, area->start_page, area->end_page
-    };
-
-    ssd1306_send_command_list(commands, count_of(commands));
-    ssd1306_send_buffer(ssd, area->buffer_length);
-}
-
-// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
-void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
-    assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
-
-    const int bytes_per_row = ssd1306_width;
-
-    int byte_idx = (y / 8) * bytes_per_row + x;
-    uint8_t byte = ssd[byte_idx];
-
-    if (set) {
-        byte |= 1 << (y % 8);
-    }
-    else {
-        byte &= ~(1 << (y % 8));
-    }
-
-    ssd[byte_idx] = byte;
-}
-
-// Algoritmo de Bresenham básico
-void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
-    int dx = abs(x_1 - x_0); // Deslocamentos
-    int dy = -abs(y_1 - y_0);
-    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
-    int sy = y_0 < y_1 ? 1 : -1;
-    int error = dx + dy; // Erro acumulado
-    int error_2;
-
-    while (true) {
-        ssd1306_set_pixel(ssd, x_0, y_0, set); // Acende pixel no ponto atual
-        if (x_0 == x_1 && y_0 == y_1) {
-            break; // Verifica se o ponto final foi alcançado
-        }
-
-        error_2 = 2 * error; // Ajusta o erro acumulado
-
-        if (error_2 >= dy) {
-            error += dy;
-            x_0 += sx; // Avança na direção x
-        }
-        if (error_2 <= dx) {
-            error += dx;
-            y_0 += sy; // Avança na direção y
-        }
-    }
-}
-
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  }
-  else
-    return 0;
-}
-
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    y = y / 8;
-
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
-
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
-    }
-}
-
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
-void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    while (*string) {
-        ssd1306_draw_char(ssd, x, y, *string++);
-        x += 8;
-    }
-}
-
-// Comando de configuração com base na estrutura ssd1306_t
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
-}
-
-// Função de configuração do display para o caso do bitmap
-void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_display | 0x00);
-    ssd1306_command(ssd, ssd1306_set_memory_mode);
-    ssd1306_command(ssd, 0x01);
-    ssd1306_command(ssd, ssd1306_set_display_start_line | 0x00);
-    ssd1306_command(ssd, ssd1306_set_segment_remap | 0x01);
-    ssd1306_command(ssd, ssd1306_set_mux_ratio);
-    ssd1306_command(ssd, ssd1306_height - 1);
-    ssd1306_command(ssd, ssd1306_set_common_output_direction | 0x08);
-    ssd1306_command(ssd, ssd1306_set_display_offset);
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, ssd1306_set_common_pin_configuration);
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, ssd1306_set_display_clock_divide_ratio);
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, ssd1306_set_precharge);
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, ssd1306_set_vcomh_deselect_level);
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, ssd1306_set_contrast);
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, ssd1306_set_entire_on);
-    ssd1306_command(ssd, ssd1306_set_normal_display);
-    ssd1306_command(ssd, ssd1306_set_charge_pump);
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, ssd1306_set_display | 0x01);
-}
-
-// Inicializa o display para o caso de exibição de bitmap
-void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
-    ssd->width = width;
-    ssd->height = height;
-    ssd->pages = height / 8U;
-    ssd->address = address;
-    ssd->i2c_port = i2c;
-    ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    ssd->ram_buffer[0] = 0x40;
-    ssd->port_buffer[0] = 0x80;
-}
-
-// Envia os dados ao display
-void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, ssd1306_set_column_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, ssd1306_set_page_address);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-    ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
-}
-
-// Desenha o bitmap (a ser fornecido em display_oled.c) no display
-void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
-    for (int i = 0; i < ssd->bufsize - 1; i++) {
-        ssd->ram_buffer[i + 1] = bitmap[i];
-
-        ssd1306_send_data(ssd);
-    }
-}
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "pico/stdlib.h"
+#include "pico/binary_info.h"
+#include "hardware/i2c.h"
+#include "ssd1306_font.h"
+#include "ssd1306_core.h"
+
+// Framebuffer único do driver, alocado estaticamente e já com o byte de controle de dados
+ssd1306_framebuffer_t ssd1306_framebuffer = { .control = ssd1306_control_data };
+static_assert(offsetof(ssd1306_framebuffer_t, data) == 1, "prefixo deve anteceder os pixels");
+
+// Painel usado pelas funções sem contexto (ssd1306_init, render_on_display, ssd1306_draw_text...):
+// geometria de ssd1306_i2c.h, no i2c1, desenhando em ssd1306_framebuffer.
+// Rastreamento de regiões sujas desativado por padrão
+ssd1306_t ssd1306_default_display = {
+    .width = ssd1306_width,
+    .height = ssd1306_height,
+    .pages = ssd1306_n_pages,
+    .address = ssd1306_i2c_address,
+    .i2c_port = i2c1,
+    .ram_buffer = &ssd1306_framebuffer.control,
+    .bufsize = sizeof(ssd1306_framebuffer),
+    .port_buffer = { 0x80 },
+};
+
+// Operação à qual a próxima transação é atribuída nos contadores de tráfego do painel
+static enum ssd1306_operation current_op = ssd1306_op_command;
+
+// Roteiros de comandos montados em tempo de compilação, já com o byte de controle,
+// para que cada um vá ao display numa única transação
+static const uint8_t init_script[] = {
+    ssd1306_control_commands,
+    ssd1306_set_display, ssd1306_set_memory_mode, 0x00,
+    ssd1306_set_display_start_line, ssd1306_set_segment_remap | 0x01,
+    ssd1306_set_mux_ratio, ssd1306_height - 1,
+    ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
+    0x00, ssd1306_set_common_pin_configuration,
+#if ((ssd1306_width == 128) && (ssd1306_height == 32))
+    0x02,
+#elif ((ssd1306_width == 128) && (ssd1306_height == 64))
+    0x12,
+#else
+    0x02,
+#endif
+    ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
+    0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
+    0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
+    ssd1306_set_charge_pump, 0x14, ssd1306_set_scroll | 0x00,
+    ssd1306_set_display | 0x01,
+};
+
+static const uint8_t scroll_on_script[] = {
+    ssd1306_control_commands,
+    ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0xFF, ssd1306_set_scroll | 0x01
+};
+
+static const uint8_t scroll_off_script[] = {
+    ssd1306_control_commands,
+    ssd1306_set_horizontal_scroll | 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0xFF, ssd1306_set_scroll | 0x00
+};
+
+// Soma tráfego à operação do painel padrão; também usado por caminhos que não passam por
+// ssd1306_write (ex.: DMA)
+void ssd1306_add_traffic(enum ssd1306_operation op, uint32_t transactions, uint32_t bytes) {
+    ssd1306_default_display.traffic[op].transactions += transactions;
+    ssd1306_default_display.traffic[op].bytes += bytes;
+}
+
+// Toda transação i2c do driver passa por aqui (ou por ssd1306_write_data, a de pixels), para
+// que o tráfego de cada painel possa ser medido.
+// O envio em si (prazos, novas tentativas, velocidade) é da camada de transporte; só as
+// transações entregues entram no tráfego da operação
+static void ssd1306_write(ssd1306_t *display, const uint8_t *buffer, size_t length) {
+    if (ssd1306_transport_write(display, buffer, length)) {
+        display->traffic[current_op].transactions++;
+        display->traffic[current_op].bytes += length + 1; // +1 pelo byte de endereço
+    }
+}
+
+// Envia 'length' bytes de pixels precedidos do byte de controle de dados, direto da memória do
+// chamador: o byte de controle vai ao FIFO como palavra própria, sem tocar no buffer
+static void ssd1306_write_data(ssd1306_t *display, const uint8_t *data, int length) {
+    if (ssd1306_transport_write_data(display, ssd1306_control_data, data, length)) {
+        display->traffic[current_op].transactions++;
+        display->traffic[current_op].bytes += length + 2; // +1 pelo byte de controle, +1 pelo de endereço
+    }
+}
+
+// Copia o tráfego acumulado de uma operação do painel padrão
+void ssd1306_get_traffic(enum ssd1306_operation op, struct ssd1306_traffic *out) {
+    *out = ssd1306_default_display.traffic[op];
+}
+
+// Zera os contadores de todas as operações do painel padrão
+void ssd1306_reset_traffic() {
+    memset(ssd1306_default_display.traffic, 0, sizeof(ssd1306_default_display.traffic));
+}
+
+// Total acumulado de bytes enviados a um painel (inclui bytes de endereço e de controle)
+uint32_t ssd1306_display_bytes_on_wire(ssd1306_t *display) {
+    uint32_t total = 0;
+    for (int op = 0; op < ssd1306_op_count; op++) {
+        total += display->traffic[op].bytes;
+    }
+    return total;
+}
+
+// Total acumulado de bytes enviados ao painel padrão
+uint32_t ssd1306_get_bytes_on_wire() {
+    return ssd1306_display_bytes_on_wire(&ssd1306_default_display);
+}
+
+// Calcular quanto do buffer será destinado à área de renderização
+void calculate_render_area_buffer_length(struct render_area *area) {
+    area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
+}
+
+// Processo de escrita do i2c espera um byte de controle, seguido por dados
+void ssd1306_send_command(uint8_t command) {
+    uint8_t buffer[2] = {0x80, command};
+    ssd1306_write(&ssd1306_default_display, buffer, 2);
+}
+
+// Envia uma lista de comandos ao hardware, em blocos de uma transação cada
+void ssd1306_send_command_list(uint8_t *ssd, int number) {
+    uint8_t buffer[33];
+    buffer[0] = ssd1306_control_commands;
+
+    while (number > 0) {
+        int chunk = number < 32 ? number : 32;
+        memcpy(buffer + 1, ssd, chunk);
+        ssd1306_write(&ssd1306_default_display, buffer, chunk + 1);
+        ssd += chunk;
+        number -= chunk;
+    }
+}
+
+// Envia dados ao display precedidos do byte de controle, direto da memória (sem cópia nem heap)
+void ssd1306_send_buffer(const uint8_t ssd[], int buffer_length) {
+    ssd1306_write_data(&ssd1306_default_display, ssd, buffer_length);
+}
+
+// Envia o roteiro de inicialização do display numa única transação
+void ssd1306_init() {
+    current_op = ssd1306_op_init;
+    ssd1306_write(&ssd1306_default_display, init_script, sizeof(init_script));
+    current_op = ssd1306_op_command;
+}
+
+// Liga ou desliga o scrolling horizontal numa única transação
+void ssd1306_scroll(bool set) {
+    current_op = ssd1306_op_scroll;
+    if (set) {
+        ssd1306_write(&ssd1306_default_display, scroll_on_script, sizeof(scroll_on_script));
+    }
+    else {
+        ssd1306_write(&ssd1306_default_display, scroll_off_script, sizeof(scroll_off_script));
+    }
+    current_op = ssd1306_op_command;
+}
+
+// Janela de endereçamento (colunas e páginas) numa única transação de comandos
+static void ssd1306_set_window(ssd1306_t *display, uint8_t start_column, uint8_t end_column, uint8_t start_page, uint8_t end_page) {
+    const uint8_t script[] = {
+        ssd1306_control_commands,
+        ssd1306_set_column_address, start_column, end_column,
+        ssd1306_set_page_address, start_page, end_page
+    };
+
+    ssd1306_write(display, script, sizeof(script));
+}
+
+// Atualiza uma parte do display com uma área de renderização
+void render_on_display(uint8_t *ssd, struct render_area *area) {
+    current_op = ssd1306_op_render;
+    ssd1306_set_window(&ssd1306_default_display, area->start_column, area->end_column, area->start_page, area->end_page);
+    ssd1306_send_buffer(ssd, area->buffer_length);
+    current_op = ssd1306_op_command;
+}
+
+// Envia 'data' para a janela 'area' de um painel
+void ssd1306_display_render_area(ssd1306_t *display, struct render_area *area, const uint8_t *data) {
+    current_op = ssd1306_op_render;
+    ssd1306_set_window(display, area->start_column, area->end_column, area->start_page, area->end_page);
+    ssd1306_write_data(display, data, area->buffer_length);
+    current_op = ssd1306_op_command;
+}
+
+// Scrolling horizontal contínuo das páginas [start_page, end_page], um passo de coluna a cada
+// 'interval' quadros. Depois de configurado, o próprio controlador move a imagem, sem tráfego
+// no barramento. O scrolling é desligado antes da reconfiguração, como exige o datasheet
+void ssd1306_display_scroll_horizontal(ssd1306_t *display, bool left, uint8_t start_page, uint8_t end_page, ssd1306_scroll_interval_t interval) {
+    const uint8_t script[] = {
+        ssd1306_control_commands,
+        ssd1306_set_scroll | 0x00,
+        ssd1306_set_horizontal_scroll | (left ? 0x01 : 0x00), 0x00, start_page, interval, end_page,
+        0x00, 0xFF, ssd1306_set_scroll | 0x01
+    };
+
+    current_op = ssd1306_op_scroll;
+    ssd1306_write(display, script, sizeof(script));
+    current_op = ssd1306_op_command;
+}
+
+// Para o scrolling. O controlador deixa a GDDRAM girada na posição em que parou: para voltar à
+// imagem original, a área precisa ser reenviada
+void ssd1306_display_scroll_stop(ssd1306_t *display) {
+    const uint8_t script[] = { ssd1306_control_commands, ssd1306_set_scroll | 0x00 };
+
+    current_op = ssd1306_op_scroll;
+    ssd1306_write(display, script, sizeof(script));
+    current_op = ssd1306_op_command;
+}
+
+// Marca todas as páginas de um painel como limpas
+void ssd1306_display_clear_dirty(ssd1306_t *display) {
+    memset(display->dirty.min_column, 0xFF, sizeof(display->dirty.min_column));
+    memset(display->dirty.max_column, 0x00, sizeof(display->dirty.max_column));
+}
+
+// Marca como alterado o retângulo de pixels (x_0, y_0)-(x_1, y_1), recortado ao painel
+void ssd1306_display_mark_dirty(ssd1306_t *display, int x_0, int y_0, int x_1, int y_1) {
+    ssd1306_dirty_rect(&display->dirty, display->width, display->height, x_0, y_0, x_1, y_1);
+}
+
+// Liga/desliga o rastreamento de regiões sujas de um painel. Ao ligar, a tela inteira é
+// marcada, pois o conteúdo atual do display é desconhecido
+void ssd1306_display_set_dirty_tracking(ssd1306_t *display, bool enable) {
+    display->dirty_tracking = enable;
+    ssd1306_display_clear_dirty(display);
+    if (enable) {
+        ssd1306_dirty_span(&display->dirty, 0, display->width - 1, 0, display->pages - 1);
+    }
+}
+
+// Procura a próxima janela suja do painel a partir da página 'page' e a descreve em 'area'
+// Retorna false quando não há mais janelas a enviar
+bool ssd1306_display_next_dirty_area(ssd1306_t *display, int page, struct render_area *area) {
+    const struct dirty_region *dirty = &display->dirty;
+
+    while (page < display->pages && dirty->min_column[page] > dirty->max_column[page]) {
+        page++;
+    }
+    if (page >= display->pages) {
+        return false;
+    }
+
+    area->start_column = dirty->min_column[page];
+    area->end_column = dirty->max_column[page];
+    area->start_page = page;
+    area->end_page = page;
+
+    // Páginas consecutivas de largura total são contíguas no buffer e vão numa só janela
+    if (area->start_column == 0 && area->end_column == display->width - 1) {
+        while (area->end_page + 1 < display->pages &&
+               dirty->min_column[area->end_page + 1] == 0 &&
+               dirty->max_column[area->end_page + 1] == display->width - 1) {
+            area->end_page++;
+        }
+    }
+
+    calculate_render_area_buffer_length(area);
+    return true;
+}
+
+// Envia ao painel apenas as janelas alteradas desde o último envio, direto do framebuffer
+// Retorna o número de bytes colocados no barramento
+int ssd1306_display_flush_dirty(ssd1306_t *display) {
+    uint32_t start = display->traffic[ssd1306_op_render].bytes;
+    uint8_t *pixels = display->ram_buffer + 1;
+    struct render_area area;
+
+    current_op = ssd1306_op_render;
+    for (int page = 0; ssd1306_display_next_dirty_area(display, page, &area); page = area.end_page + 1) {
+        ssd1306_set_window(display, area.start_column, area.end_column, area.start_page, area.end_page);
+        ssd1306_write_data(display, pixels + area.start_page * display->width + area.start_column, area.buffer_length);
+    }
+    current_op = ssd1306_op_command;
+
+    ssd1306_display_clear_dirty(display);
+    return display->traffic[ssd1306_op_render].bytes - start;
+}
+
+// Versões das funções acima para o painel padrão
+void ssd1306_clear_dirty() {
+    ssd1306_display_clear_dirty(&ssd1306_default_display);
+}
+
+void ssd1306_mark_dirty(int x_0, int y_0, int x_1, int y_1) {
+    ssd1306_display_mark_dirty(&ssd1306_default_display, x_0, y_0, x_1, y_1);
+}
+
+void ssd1306_set_dirty_tracking(bool enable) {
+    ssd1306_display_set_dirty_tracking(&ssd1306_default_display, enable);
+}
+
+bool ssd1306_next_dirty_area(int page, struct render_area *area) {
+    return ssd1306_display_next_dirty_area(&ssd1306_default_display, page, area);
+}
+
+// Envia ao display apenas as janelas alteradas desde o último envio
+// Retorna o número de bytes colocados no barramento
+int render_dirty_on_display(uint8_t *ssd) {
+    uint32_t start = ssd1306_default_display.traffic[ssd1306_op_render].bytes;
+    struct render_area area;
+
+    for (int page = 0; ssd1306_next_dirty_area(page, &area); page = area.end_page + 1) {
+        render_on_display(ssd + area.start_page * ssd1306_width + area.start_column, &area);
+    }
+
+    ssd1306_clear_dirty();
+    return ssd1306_default_display.traffic[ssd1306_op_render].bytes - start;
+}
+
+// Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
+ssd1306_core void ssd1306_set_pixel_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, bool set) {
+    assert(x >= 0 && x < columns && y >= 0 && y < rows);
+
+    const int bytes_per_row = columns;
+
+    int byte_idx = (y / 8) * bytes_per_row + x;
+    uint8_t byte = ssd[byte_idx];
+
+    if (set) {
+        byte |= 1 << (y % 8);
+    }
+    else {
+        byte &= ~(1 << (y % 8));
+    }
+
+    if (dirty && byte != ssd[byte_idx]) {
+        ssd1306_dirty_span(dirty, x, x, y / 8, y / 8);
+    }
+
+    ssd[byte_idx] = byte;
+}
+
+void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
+    ssd1306_legacy(ssd1306_set_pixel_core, ssd, x, y, set);
+}
+
+void ssd1306_display_set_pixel(ssd1306_t *display, int x, int y, bool set) {
+    ssd1306_dispatch(display, ssd1306_set_pixel_core, x, y, set);
+}
+
+// Algoritmo de Bresenham básico; linhas horizontais e verticais ficam com as primitivas de span
+ssd1306_core void ssd1306_draw_line_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x_0, int y_0, int x_1, int y_1, bool set) {
+    int dx = abs(x_1 - x_0); // Deslocamentos
+    int dy = -abs(y_1 - y_0);
+    int sx = x_0 < x_1 ? 1 : -1; // Direção de avanço
+    int sy = y_0 < y_1 ? 1 : -1;
+    int error = dx + dy; // Erro acumulado
+    int error_2;
+
+    while (true) {
+        ssd1306_set_pixel_core(ssd, columns, rows, dirty, x_0, y_0, set); // Acende pixel no ponto atual
+        if (x_0 == x_1 && y_0 == y_1) {
+            break; // Verifica se o ponto final foi alcançado
+        }
+
+        error_2 = 2 * error; // Ajusta o erro acumulado
+
+        if (error_2 >= dy) {
+            error += dy;
+            x_0 += sx; // Avança na direção x
+        }
+        if (error_2 <= dx) {
+            error += dx;
+            y_0 += sy; // Avança na direção y
+        }
+    }
+}
+
+void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
+    // Linhas horizontais e verticais viram spans, sem passar pixel a pixel
+    if (y_0 == y_1) {
+        ssd1306_draw_hline(ssd, x_0, x_1, y_0, set ? ssd1306_mode_set : ssd1306_mode_clear);
+        return;
+    }
+    if (x_0 == x_1) {
+        ssd1306_draw_vline(ssd, x_0, y_0, y_1, set ? ssd1306_mode_set : ssd1306_mode_clear);
+        return;
+    }
+
+    ssd1306_legacy(ssd1306_draw_line_core, ssd, x_0, y_0, x_1, y_1, set);
+}
+
+void ssd1306_display_draw_line(ssd1306_t *display, int x_0, int y_0, int x_1, int y_1, bool set) {
+    if (y_0 == y_1) {
+        ssd1306_display_draw_hline(display, x_0, x_1, y_0, set ? ssd1306_mode_set : ssd1306_mode_clear);
+        return;
+    }
+    if (x_0 == x_1) {
+        ssd1306_display_draw_vline(display, x_0, y_0, y_1, set ? ssd1306_mode_set : ssd1306_mode_clear);
+        return;
+    }
+
+    ssd1306_dispatch(display, ssd1306_draw_line_core, x_0, y_0, x_1, y_1, set);
+}
+
+// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
+static inline int ssd1306_get_font(uint8_t character)
+{
+  if (character >= 'A' && character <= 'Z') {
+    return character - 'A' + 1;
+  }
+  else if (character >= '0' && character <= '9') {
+    return character - '0' + 27;
+  }
+  else
+    return 0;
+}
+
+// Desenha um único caractere no display
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+        return;
+    }
+
+    y = y / 8;
+
+    character = toupper(character);
+    int idx = ssd1306_get_font(character);
+    int fb_idx = y * 128 + x;
+    int changed_min = 8, changed_max = -1;
+
+    for (int i = 0; i < 8; i++) {
+        if (ssd[fb_idx] != font[idx * 8 + i]) {
+            ssd[fb_idx] = font[idx * 8 + i];
+            if (i < changed_min) changed_min = i;
+            changed_max = i;
+        }
+        fb_idx++;
+    }
+
+    if (changed_max >= 0) {
+        ssd1306_dirty_span(ssd1306_dirty_of(&ssd1306_default_display), x + changed_min, x + changed_max, y, y);
+    }
+}
+
+// Desenha uma string, chamando a função de desenhar caractere várias vezes
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
+    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+        return;
+    }
+
+    while (*string) {
+        ssd1306_draw_char(ssd, x, y, *string++);
+        x += 8;
+    }
+}
+
+// Comando de configuração com base na estrutura ssd1306_t
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd->port_buffer[1] = command;
+  ssd1306_write(ssd, ssd->port_buffer, 2);
+}
+
+// Configura o painel conforme a sua geometria e alimentação, numa única transação. Usa o
+// endereçamento horizontal, o mesmo layout de páginas do framebuffer e das primitivas de desenho
+void ssd1306_config(ssd1306_t *ssd) {
+    const uint8_t script[] = {
+        ssd1306_control_commands,
+        ssd1306_set_display | 0x00, ssd1306_set_memory_mode, 0x00,
+        ssd1306_set_display_start_line | 0x00, ssd1306_set_segment_remap | 0x01,
+        ssd1306_set_mux_ratio, ssd->height - 1,
+        ssd1306_set_common_output_direction | 0x08, ssd1306_set_display_offset,
+        0x00, ssd1306_set_common_pin_configuration, ssd->height == 64 ? 0x12 : 0x02,
+        ssd1306_set_display_clock_divide_ratio, 0x80, ssd1306_set_precharge,
+        ssd->external_vcc ? 0x22 : 0xF1, ssd1306_set_vcomh_deselect_level, 0x30, ssd1306_set_contrast,
+        0xFF, ssd1306_set_entire_on, ssd1306_set_normal_display,
+        ssd1306_set_charge_pump, ssd->external_vcc ? 0x10 : 0x14, ssd1306_set_scroll | 0x00,
+        ssd1306_set_display | 0x01,
+    };
+
+    current_op = ssd1306_op_init;
+    ssd1306_write(ssd, script, sizeof(script));
+    current_op = ssd1306_op_command;
+}
+
+// Preenche o contexto de um painel, desenhando em 'buffer' (ssd1306_framebuffer_size(width, height) bytes)
+static void ssd1306_setup(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer) {
+    assert(width <= ssd1306_max_width && height % ssd1306_page_height == 0 && height / ssd1306_page_height <= ssd1306_max_pages);
+
+    ssd->width = width;
+    ssd->height = height;
+    ssd->pages = height / 8U;
+    ssd->address = address;
+    ssd->i2c_port = i2c;
+    ssd->external_vcc = external_vcc;
+    ssd->bufsize = ssd1306_framebuffer_size(width, height);
+
+    // O prefixo do framebuffer é o byte de controle de dados
+    ssd->ram_buffer = buffer;
+    ssd->ram_buffer[0] = ssd1306_control_data;
+    memset(ssd->ram_buffer + 1, 0, ssd->bufsize - 1);
+    ssd->port_buffer[0] = 0x80;
+
+    ssd->dirty_tracking = false;
+    ssd1306_display_clear_dirty(ssd);
+    memset(ssd->traffic, 0, sizeof(ssd->traffic));
+    memset(&ssd->link, 0, sizeof(ssd->link));
+}
+
+// Inicializa o display para o caso de exibição de bitmap, usando o framebuffer estático
+void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    assert(ssd1306_framebuffer_size(width, height) <= sizeof(ssd1306_framebuffer));
+    ssd1306_setup(ssd, width, height, external_vcc, address, i2c, &ssd1306_framebuffer.control);
+}
+
+// Inicializa e configura um painel com framebuffer próprio, para usar vários displays ao mesmo tempo:
+//   static uint8_t buffer[ssd1306_framebuffer_size(128, 32)];
+//   ssd1306_display_init(&display, 128, 32, false, 0x3C, i2c0, buffer);
+void ssd1306_display_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c, uint8_t *buffer) {
+    ssd1306_setup(ssd, width, height, external_vcc, address, i2c, buffer);
+    ssd1306_config(ssd);
+}
+
+// Envia os dados ao display
+void ssd1306_send_data(ssd1306_t *ssd) {
+    current_op = ssd1306_op_render;
+    ssd1306_set_window(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+    ssd1306_write(ssd, ssd->ram_buffer, ssd->bufsize);
+    current_op = ssd1306_op_command;
+}
+
+// Desenha um bitmap de tela inteira (no layout de páginas) no display: copia a imagem e envia uma vez
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap) {
+    memcpy(ssd->ram_buffer + 1, bitmap, ssd->bufsize - 1);
+    ssd1306_send_data(ssd);
+}
@@ -1,68 +1,341 @@
-#include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
-
-#ifndef ssd1306_inc_h
-#define ssd1306_inc_h
-
-#define ssd1306_height 64 // Define a altura do display (32 pixels)
-#define ssd1306_width 128 // Define a largura do display (128 pixels)
-
-#define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
-
-#define ssd1306_i2c_clock 400 // Define o tempo do clock (pode ser aumentado)
-
-// Comandos de configuração (endereços)
-#define ssd1306_set_memory_mode _u(0x20)
-#define ssd1306_set_column_address _u(0x21)
-#define ssd1306_set_page_address _u(0x22)
-#define ssd1306_set_horizontal_scroll _u(0x26)
-#define ssd1306_set_scroll _u(0x2E)
-
-#define ssd1306_set_display_start_line _u(0x40)
-
-#define ssd1306_set_contrast _u(0x81)
-#define ssd1306_set_charge_pump _u(0x8D)
-
-#define ssd1306_set_segment_remap _u(0xA0)
-#define ssd1306_set_entire_on _u(0xA4)
-#define ssd1306_set_all_on _u(0xA5)
-#define ssd1306_set_normal_display _u(0xA6)
-#define ssd1306_set_inverse_display _u(0xA7)
-#define ssd1306_set_mux_ratio _u(0xA8)
-#define ssd1306_set_display _u(0xAE)
-#define ssd1306_set_common_output_direction _u(0xC0)
-#define ssd1306_set_common_output_direction_flip _u(0xC0)
-
-#define ssd1306_set_display_offset _u(0xD3)
-#define ssd1306_set_display_clock_divide_ratio _u(0xD5)
-#define ssd1306_set_precharge _u(0xD9)
-#define ssd1306_set_common_pin_configuration _u(0xDA)
-#define ssd1306_set_vcomh_deselect_level _u(0xDB)
-
-#define ssd1306_page_height _u(8)
-#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
-#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
-
-#define ssd1306_write_mode _u(0xFE)
-#define ssd1306_read_mode _u(0xFF)
-
-struct render_area {
-    uint8_t start_column;
-    uint8_t end_column;
-    uint8_t start_page;
-    uint8_t end_page;
-
-    int buffer_length;
-};
-
-typedef struct {
-  uint8_t width, height, pages, address;
-  i2c_inst_t * i2c_port;
-  bool external_vcc;
-  uint8_t *ram_buffer;
-  size_t bufsize;
-  uint8_t port_buffer[2];
-} ssd1306_t;
-
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifndef ssd1306_inc_h
+#define ssd1306_inc_h
+
+#define ssd1306_height 64 // Define a altura do display (32 pixels)
+#define ssd1306_width 128 // Define a largura do display (128 pixels)
+
+#define ssd1306_i2c_address _u(0x3C) // Define o endereço do i2c do display
+
+#define ssd1306_i2c_clock 400 // Define o tempo do clock (pode ser aumentado)
+
+// Velocidades tentadas pela negociação do barramento (ssd1306_transport_negotiate), em Hz
+#define ssd1306_i2c_fast_mode_plus 1000000
+#define ssd1306_i2c_fast_mode 400000
+#define ssd1306_i2c_standard_mode 100000
+
+#define ssd1306_i2c_retries 2              // Novas tentativas antes de reduzir a velocidade
+#define ssd1306_i2c_timeout_margin_us 500  // Folga somada ao prazo de cada transação
+#define ssd1306_i2c_probe_count 4          // NOPs que o painel precisa aceitar numa velocidade
+
+// Comandos de configuração (endereços)
+#define ssd1306_set_memory_mode _u(0x20)
+#define ssd1306_set_column_address _u(0x21)
+#define ssd1306_set_page_address _u(0x22)
+#define ssd1306_set_horizontal_scroll _u(0x26)
+#define ssd1306_set_scroll _u(0x2E)
+
+#define ssd1306_set_display_start_line _u(0x40)
+
+#define ssd1306_set_contrast _u(0x81)
+#define ssd1306_set_charge_pump _u(0x8D)
+
+#define ssd1306_set_segment_remap _u(0xA0)
+#define ssd1306_set_entire_on _u(0xA4)
+#define ssd1306_set_all_on _u(0xA5)
+#define ssd1306_set_normal_display _u(0xA6)
+#define ssd1306_set_inverse_display _u(0xA7)
+#define ssd1306_set_mux_ratio _u(0xA8)
+#define ssd1306_set_display _u(0xAE)
+#define ssd1306_set_common_output_direction _u(0xC0)
+#define ssd1306_set_common_output_direction_flip _u(0xC0)
+
+#define ssd1306_set_display_offset _u(0xD3)
+#define ssd1306_set_display_clock_divide_ratio _u(0xD5)
+#define ssd1306_set_precharge _u(0xD9)
+#define ssd1306_set_common_pin_configuration _u(0xDA)
+#define ssd1306_set_vcomh_deselect_level _u(0xDB)
+
+#define ssd1306_page_height _u(8)
+#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
+#define ssd1306_buffer_length (ssd1306_n_pages * ssd1306_width)
+
+// Limites do controlador: 128 colunas e 64 linhas (8 páginas), seja qual for o painel
+#define ssd1306_max_width 128
+#define ssd1306_max_pages 8
+
+// Bytes do framebuffer de um painel, incluindo o byte de controle que antecede os pixels
+#define ssd1306_framebuffer_size(width, height) ((width) * ((height) / ssd1306_page_height) + 1)
+
+// Bytes de controle: 0x00 indica que o resto da transação são comandos, 0x40 que são dados
+#define ssd1306_control_commands _u(0x00)
+#define ssd1306_control_data _u(0x40)
+
+#define ssd1306_write_mode _u(0xFE)
+#define ssd1306_read_mode _u(0xFF)
+
+struct render_area {
+    uint8_t start_column;
+    uint8_t end_column;
+    uint8_t start_page;
+    uint8_t end_page;
+
+    int buffer_length;
+};
+
+// Framebuffer com o byte de controle reservado logo antes dos pixels, para que um
+// quadro vá ao i2c direto desta memória, sem cópia nem alocação
+typedef struct {
+    uint8_t control; // sempre ssd1306_control_data
+    uint8_t data[ssd1306_buffer_length];
+} ssd1306_framebuffer_t;
+
+// Modo de desenho das primitivas rápidas
+typedef enum {
+    ssd1306_mode_clear = 0,
+    ssd1306_mode_set = 1,
+    ssd1306_mode_invert = 2, // XOR
+} ssd1306_draw_mode_t;
+
+// Bitmap no formato de páginas do SSD1306: para cada página (8 linhas), 'width' bytes
+// verticais com o bit menos significativo em cima. Se 'rle' for verdadeiro, 'data' está
+// compactado em blocos: cabeçalho 1nnnnnnn repete o byte seguinte n+1 vezes,
+// cabeçalho 0nnnnnnn é seguido de n+1 bytes literais
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    bool rle;
+    const uint8_t *data;
+} ssd1306_bitmap_t;
+
+// Fonte de até 8 linhas em colunas verticais. 'index' leva qualquer código Latin-1 ao número
+// do glyph em O(1); fontes proporcionais (width == 0) trazem início e largura de cada glyph
+typedef struct {
+    uint8_t height;          // linhas desenhadas (máx. 8)
+    uint8_t width;           // largura fixa dos glyphs, ou 0 se proporcional
+    uint8_t spacing;         // colunas em branco após cada glyph
+    const uint8_t *index;    // 256 entradas: código -> número do glyph
+    const uint8_t *glyphs;   // colunas de todos os glyphs
+    const uint16_t *offsets; // início de cada glyph em 'glyphs' (só proporcional)
+    const uint8_t *widths;   // largura de cada glyph (só proporcional)
+} ssd1306_font_t;
+
+// Faixa de colunas alteradas em cada página (modo de rastreamento de regiões sujas)
+// Uma página está limpa quando min_column > max_column
+struct dirty_region {
+    uint8_t min_column[ssd1306_max_pages];
+    uint8_t max_column[ssd1306_max_pages];
+};
+
+// Operações do driver cujo tráfego i2c é contabilizado separadamente
+enum ssd1306_operation {
+    ssd1306_op_init,    // roteiros de inicialização
+    ssd1306_op_scroll,  // configuração do scrolling
+    ssd1306_op_render,  // janelas de endereçamento + dados do framebuffer
+    ssd1306_op_command, // comandos avulsos
+    ssd1306_op_count
+};
+
+// Transações e bytes no barramento (endereço + byte de controle + dados)
+struct ssd1306_traffic {
+    uint32_t transactions;
+    uint32_t bytes;
+};
+
+// Contadores do enlace i2c de um painel, mantidos pela camada de transporte
+struct ssd1306_link_stats {
+    uint32_t transactions; // transações entregues
+    uint32_t bytes;        // bytes entregues, com o byte de endereço
+    uint32_t nacks;        // tentativas recusadas (NACK ou perda de arbitragem)
+    uint32_t timeouts;     // tentativas que estouraram o prazo (ex.: barramento preso)
+    uint32_t retries;      // tentativas repetidas na mesma velocidade
+    uint32_t failures;     // transações abandonadas
+    uint32_t busy_us;      // tempo no barramento, incluindo as tentativas que falharam
+    uint32_t baudrate;     // velocidade atual do controlador (preenchida na cópia)
+};
+
+// Intervalo entre passos do scrolling horizontal, em quadros (código do comando 0x26/0x27)
+typedef enum {
+    ssd1306_scroll_2_frames = 7,
+    ssd1306_scroll_3_frames = 4,
+    ssd1306_scroll_4_frames = 5,
+    ssd1306_scroll_5_frames = 0,
+    ssd1306_scroll_25_frames = 6,
+    ssd1306_scroll_64_frames = 1,
+    ssd1306_scroll_128_frames = 2,
+    ssd1306_scroll_256_frames = 3,
+} ssd1306_scroll_interval_t;
+
+// Chamada (em contexto de interrupção) quando o último byte de um envio assíncrono entra no FIFO do i2c
+typedef void (*ssd1306_async_callback_t)(void);
+
+// Contexto de um painel: barramento, endereço, geometria, framebuffer (ram_buffer[0] é o byte
+// de controle, os pixels vêm logo depois), regiões sujas, tráfego e enlace. Cada painel tem o seu,
+// então vários displays (128x32, 128x64, em i2c0 e i2c1) funcionam ao mesmo tempo
+typedef struct {
+  uint8_t width, height, pages, address;
+  i2c_inst_t * i2c_port;
+  bool external_vcc;
+  uint8_t *ram_buffer;
+  size_t bufsize;
+  uint8_t port_buffer[2];
+  bool dirty_tracking;
+  struct dirty_region dirty;
+  struct ssd1306_traffic traffic[ssd1306_op_count];
+  struct ssd1306_link_stats link;
+} ssd1306_t;
+
+// Console de texto rolante. As 8 páginas da GDDRAM formam um anel de linhas: uma linha nova é
+// desenhada só no buffer 'line' e enviada como uma página, e a rolagem é feita movendo a linha
+// inicial do display (comando 0x40 | linha), sem reenviar as demais páginas
+typedef struct {
+  ssd1306_t *display;
+  const ssd1306_font_t *font;
+  ssd1306_t line_view;                   // 'line' visto como um painel de uma página
+  uint8_t line[ssd1306_max_width + 1];   // [0] reservado ao byte de controle
+  uint8_t top_page;                      // página da GDDRAM exibida na primeira linha
+  uint8_t row;                           // linha do cursor na tela
+  uint8_t x;                             // coluna do cursor
+  bool newline_pending;                  // '\n' recebido; a rolagem espera o próximo caractere
+  bool line_dirty;
+  bool start_line_dirty;
+} ssd1306_console_t;
+
+// Widgets retidos: cada um lembra o que já desenhou e, a cada atualização, redesenha só as
+// células de glyph (ou o trecho da barra) que mudaram. As primitivas marcam como sujos apenas
+// esses trechos, então o flush seguinte envia só eles
+#define ssd1306_widget_text_length 24 // glyphs de um rótulo ou campo numérico
+#define ssd1306_widget_max_decimals 9 // casas de um campo numérico (a escala 10^casas cabe em 32 bits)
+
+typedef enum {
+    ssd1306_widget_label,  // texto livre
+    ssd1306_widget_number, // valor em ponto fixo, alinhado à direita num campo de largura fixa
+    ssd1306_widget_bar,    // barra horizontal com contorno
+    ssd1306_widget_icon,   // bitmap trocável
+} ssd1306_widget_type_t;
+
+typedef struct {
+    ssd1306_widget_type_t type;
+    ssd1306_t *display;
+    int16_t x, y;
+    bool valid; // false até o primeiro desenho (ou depois de ssd1306_widget_invalidate)
+    union {
+        struct {
+            const ssd1306_font_t *font;
+            uint8_t columns;  // campo numérico: largura em caracteres
+            uint8_t decimals; // campo numérico: casas decimais do valor
+            uint8_t length;   // glyphs na tela
+            int16_t end;      // coluna logo após o último glyph na tela
+            uint8_t codes[ssd1306_widget_text_length]; // códigos Latin-1 na tela
+        } text;
+        struct {
+            int16_t width, height;
+            int32_t min, max;
+            int16_t filled; // colunas preenchidas na tela
+        } bar;
+        struct {
+            const ssd1306_bitmap_t *bitmap; // bitmap na tela (NULL = vazio)
+        } icon;
+    };
+} ssd1306_widget_t;
+
+// Gráfico rolante (strip chart) numa janela de páginas inteiras. Cada coluna mostra a faixa
+// (mínimo a máximo) das amostras que recebeu; a cada coluna nova, as linhas de cada página são
+// deslocadas uma coluna para a esquerda no próprio framebuffer e só a última coluna é desenhada.
+// Com a escala automática, uma faixa nova que não cabe no eixo Y (ou que ocupa menos da metade
+// dele) redesenha o gráfico inteiro a partir do histórico
+typedef struct {
+    ssd1306_t *display;
+    uint8_t x, width;          // colunas [x, x + width)
+    uint8_t page, pages;       // páginas [page, page + pages)
+    bool auto_scale;
+    int32_t scale_min, scale_max;
+    uint16_t samples_per_column;
+    uint16_t pending;                  // amostras já acumuladas na próxima coluna
+    int32_t pending_min, pending_max;
+    uint8_t count;                     // colunas com dados
+    uint8_t head;                      // posição no anel da coluna mais antiga
+    int32_t column_min[ssd1306_max_width];
+    int32_t column_max[ssd1306_max_width];
+    uint32_t columns_drawn;            // colunas novas (deslocamento + uma coluna)
+    uint32_t rescales;                 // redesenhos completos por mudança de escala
+} ssd1306_chart_t;
+
+// Tons de cinza por modulação temporal: dois planos de bits por pixel (4 níveis) enviados em
+// rodízio, o plano 1 em dois quadros de cada três e o plano 0 em um, de modo que o brilho
+// percebido de um nível é proporcional a ele (0, 1/3, 2/3, 1)
+#define ssd1306_gray_levels 4
+#define ssd1306_gray_phases 3
+
+// Contadores do modo de cinza: quadros enviados, ticks do timer em que o envio anterior ainda
+// estava no barramento (quadro atrasado), bytes e tempo desde o início
+struct ssd1306_gray_stats {
+    uint32_t frames;
+    uint32_t late;
+    uint32_t bytes;
+    uint32_t elapsed_us;
+    uint32_t frame_us;  // tempo teórico de um quadro no barramento
+};
+
+// Janela em tons de cinza sobre o painel padrão. Cada plano é um framebuffer completo, com uma
+// visão de painel (plane_view) para desenhar nele com as primitivas de contexto; só a janela
+// [x, x + width) x [page, page + pages) vai ao display, por DMA (ssd1306_async)
+typedef struct {
+    ssd1306_framebuffer_t planes[2];
+    ssd1306_t plane_view[2];
+    struct render_area area;
+    repeating_timer_t timer;
+    bool running;
+    volatile uint8_t phase;            // posição no rodízio dos planos
+    volatile uint32_t frames, late, bytes;
+    uint32_t started_us, stopped_us;
+} ssd1306_gray_t;
+
+// Comandos aceitos pelo serviço de display no núcleo 1
+typedef enum {
+    ssd1306_service_op_text,
+    ssd1306_service_op_fill_rect,
+    ssd1306_service_op_rect,
+    ssd1306_service_op_line,
+    ssd1306_service_op_circle,
+    ssd1306_service_op_fill_circle,
+    ssd1306_service_op_image,
+    ssd1306_service_op_chart,
+    ssd1306_service_op_widget_text,
+    ssd1306_service_op_widget_number,
+    ssd1306_service_op_widget_bar,
+    ssd1306_service_op_widget_icon,
+    ssd1306_service_op_flush,
+} ssd1306_service_op_t;
+
+#define ssd1306_service_text_length 32   // texto copiado para a fila, com o terminador
+#define ssd1306_service_queue_length 32  // potência de 2
+
+// Uma entrada da fila. Os campos usados dependem da operação: linha usa (x, y)-(x_1, y_1),
+// círculo usa 'radius', gráfico usa 'chart' e 'value', widget usa 'widget' e 'text', 'value' ou
+// 'icon'; textos são copiados, fontes e bitmaps são referências a dados constantes
+typedef struct {
+    uint8_t op;   // ssd1306_service_op_t
+    uint8_t mode; // ssd1306_draw_mode_t
+    int16_t x, y;
+    union {
+        struct { int16_t width, height; };
+        struct { int16_t x_1, y_1; };
+        int16_t radius;
+        int32_t value;
+        const ssd1306_bitmap_t *icon;
+    };
+    union {
+        const ssd1306_font_t *font;
+        const ssd1306_bitmap_t *bitmap;
+        ssd1306_chart_t *chart;
+        ssd1306_widget_t *widget;
+    };
+    char text[ssd1306_service_text_length];
+} ssd1306_service_command_t;
+
+// Estatísticas do serviço, lidas pelo núcleo 0
+struct ssd1306_service_stats {
+    uint32_t depth;          // comandos na fila agora
+    uint32_t max_depth;      // maior ocupação já vista
+    uint32_t posted;         // comandos enviados pelo produtor
+    uint32_t stalls;         // vezes em que o produtor encontrou a fila cheia
+    uint32_t worst_stall_us; // maior espera do produtor por uma vaga
+    uint32_t flushes;        // envios do framebuffer feitos pelo núcleo 1
+    uint32_t flush_bytes;    // bytes desses envios
+};
+
 #endif
\ No newline at end of file
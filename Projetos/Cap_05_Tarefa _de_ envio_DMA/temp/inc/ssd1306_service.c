@@ -0,0 +1,278 @@
+#include <stddef.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#include "ssd1306.h"
+
+// Serviço de display no núcleo 1. O núcleo 0 (produtor) coloca comandos de desenho e de envio
+// numa fila circular de um produtor e um consumidor; o núcleo 1 (consumidor) é o único a tocar
+// no framebuffer e no i2c do painel. Cada índice é escrito por um só núcleo, então a fila não
+// precisa de trava: basta a barreira entre gravar a entrada e publicar o novo índice
+
+static ssd1306_service_command_t queue[ssd1306_service_queue_length];
+static volatile uint32_t head = 0; // próxima vaga (escrito só pelo núcleo 0)
+static volatile uint32_t tail = 0; // próximo comando (escrito só pelo núcleo 1)
+
+static ssd1306_t *service_display = NULL;
+
+// Contadores do produtor e do consumidor (cada um escreve só os seus)
+static uint32_t posted = 0, stalls = 0, worst_stall_us = 0, max_depth = 0;
+static volatile uint32_t flushes = 0, flush_bytes = 0;
+
+// Executa um comando no núcleo 1
+static void ssd1306_service_execute(const ssd1306_service_command_t *command) {
+    ssd1306_t *display = service_display;
+
+    switch (command->op) {
+        case ssd1306_service_op_text:
+            ssd1306_display_draw_text(display, command->x, command->y, command->text, command->font);
+            break;
+        case ssd1306_service_op_fill_rect:
+            ssd1306_display_fill_rect(display, command->x, command->y, command->width, command->height, command->mode);
+            break;
+        case ssd1306_service_op_rect:
+            ssd1306_display_draw_rect(display, command->x, command->y, command->width, command->height, command->mode);
+            break;
+        case ssd1306_service_op_line:
+            ssd1306_display_draw_line(display, command->x, command->y, command->x_1, command->y_1, command->mode != ssd1306_mode_clear);
+            break;
+        case ssd1306_service_op_circle:
+            ssd1306_display_draw_circle(display, command->x, command->y, command->radius, command->mode);
+            break;
+        case ssd1306_service_op_fill_circle:
+            ssd1306_display_fill_circle(display, command->x, command->y, command->radius, command->mode);
+            break;
+        case ssd1306_service_op_image:
+            ssd1306_display_draw_image(display, command->x, command->y, command->bitmap);
+            break;
+        case ssd1306_service_op_chart:
+            ssd1306_chart_push(command->chart, command->value);
+            break;
+        case ssd1306_service_op_widget_text:
+            ssd1306_widget_set_text(command->widget, command->text);
+            break;
+        case ssd1306_service_op_widget_number:
+            ssd1306_widget_set_number(command->widget, command->value);
+            break;
+        case ssd1306_service_op_widget_bar:
+            ssd1306_widget_set_bar(command->widget, command->value);
+            break;
+        case ssd1306_service_op_widget_icon:
+            ssd1306_widget_set_icon(command->widget, command->icon);
+            break;
+        case ssd1306_service_op_flush:
+            flush_bytes += ssd1306_display_flush_dirty(display);
+            flushes++;
+            break;
+    }
+}
+
+// Consome um comando da fila; retorna false se ela estiver vazia
+bool ssd1306_service_poll() {
+    uint32_t index = tail;
+    if (index == head) {
+        return false;
+    }
+    __dmb(); // lê a entrada só depois de ver o índice publicado
+
+    ssd1306_service_execute(&queue[index % ssd1306_service_queue_length]);
+
+    __dmb();
+    tail = index + 1;
+    return true;
+}
+
+// Laço do núcleo 1: dorme em WFE enquanto a fila estiver vazia (o produtor acorda com SEV).
+// O núcleo 1 aceita ser pausado pelo núcleo 0 durante gravações na flash (flash_safe_execute)
+static void ssd1306_service_main() {
+    multicore_lockout_victim_init();
+    while (true) {
+        if (!ssd1306_service_poll()) {
+            __wfe();
+        }
+    }
+}
+
+// Inicia o serviço no núcleo 1 para um painel já inicializado. A partir daqui, só o serviço
+// pode chamar funções do driver para esse painel
+void ssd1306_service_start(ssd1306_t *display) {
+    service_display = display;
+    ssd1306_display_set_dirty_tracking(display, true);
+    multicore_launch_core1(ssd1306_service_main);
+}
+
+// Reserva a próxima vaga da fila. Com a fila cheia, espera o núcleo 1 e registra a espera
+static ssd1306_service_command_t *ssd1306_service_reserve() {
+    if (head - tail >= ssd1306_service_queue_length) {
+        uint32_t start = time_us_32();
+        while (head - tail >= ssd1306_service_queue_length) {
+            tight_loop_contents();
+        }
+        uint32_t stall = time_us_32() - start;
+        stalls++;
+        if (stall > worst_stall_us) {
+            worst_stall_us = stall;
+        }
+    }
+
+    ssd1306_service_command_t *command = &queue[head % ssd1306_service_queue_length];
+    memset(command, 0, offsetof(ssd1306_service_command_t, text));
+    return command;
+}
+
+// Publica a entrada reservada e acorda o núcleo 1
+static void ssd1306_service_publish() {
+    __dmb(); // a entrada fica visível antes do índice
+    head = head + 1;
+    __sev();
+
+    posted++;
+    uint32_t depth = head - tail;
+    if (depth > max_depth) {
+        max_depth = depth;
+    }
+}
+
+// Comandos para o núcleo 0; nenhum deles toca no i2c
+
+void ssd1306_service_draw_text(int x, int y, const char *text, const ssd1306_font_t *font) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_text;
+    command->x = x;
+    command->y = y;
+    command->font = font;
+    strncpy(command->text, text, ssd1306_service_text_length - 1);
+    command->text[ssd1306_service_text_length - 1] = '\0';
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_fill_rect(int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_fill_rect;
+    command->mode = mode;
+    command->x = x;
+    command->y = y;
+    command->width = width;
+    command->height = height;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_draw_rect(int x, int y, int width, int height, ssd1306_draw_mode_t mode) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_rect;
+    command->mode = mode;
+    command->x = x;
+    command->y = y;
+    command->width = width;
+    command->height = height;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_draw_line(int x_0, int y_0, int x_1, int y_1, ssd1306_draw_mode_t mode) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_line;
+    command->mode = mode;
+    command->x = x_0;
+    command->y = y_0;
+    command->x_1 = x_1;
+    command->y_1 = y_1;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_draw_circle(int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_circle;
+    command->mode = mode;
+    command->x = x_c;
+    command->y = y_c;
+    command->radius = radius;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_fill_circle(int x_c, int y_c, int radius, ssd1306_draw_mode_t mode) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_fill_circle;
+    command->mode = mode;
+    command->x = x_c;
+    command->y = y_c;
+    command->radius = radius;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_draw_image(int x, int y, const ssd1306_bitmap_t *bitmap) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_image;
+    command->x = x;
+    command->y = y;
+    command->bitmap = bitmap;
+    ssd1306_service_publish();
+}
+
+// Acrescenta uma amostra a um gráfico do painel do serviço (o gráfico passa a ser do núcleo 1)
+void ssd1306_service_chart_push(ssd1306_chart_t *chart, int32_t value) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_chart;
+    command->chart = chart;
+    command->value = value;
+    ssd1306_service_publish();
+}
+
+// Atualizações de widgets do painel do serviço: criados no núcleo 0 (a inicialização não desenha),
+// eles passam a ser do núcleo 1, que redesenha só o que mudou
+
+void ssd1306_service_widget_set_text(ssd1306_widget_t *widget, const char *text) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_widget_text;
+    command->widget = widget;
+    strncpy(command->text, text, ssd1306_service_text_length - 1);
+    command->text[ssd1306_service_text_length - 1] = '\0';
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_widget_set_number(ssd1306_widget_t *widget, int32_t value) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_widget_number;
+    command->widget = widget;
+    command->value = value;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_widget_set_bar(ssd1306_widget_t *widget, int32_t value) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_widget_bar;
+    command->widget = widget;
+    command->value = value;
+    ssd1306_service_publish();
+}
+
+void ssd1306_service_widget_set_icon(ssd1306_widget_t *widget, const ssd1306_bitmap_t *bitmap) {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_widget_icon;
+    command->widget = widget;
+    command->icon = bitmap;
+    ssd1306_service_publish();
+}
+
+// Pede ao núcleo 1 o envio das regiões alteradas
+void ssd1306_service_flush() {
+    ssd1306_service_command_t *command = ssd1306_service_reserve();
+    command->op = ssd1306_service_op_flush;
+    ssd1306_service_publish();
+}
+
+// Indica se o núcleo 1 já executou todos os comandos enviados
+bool ssd1306_service_idle() {
+    return head == tail;
+}
+
+// Estatísticas da fila e dos envios
+void ssd1306_service_get_stats(struct ssd1306_service_stats *out) {
+    out->depth = head - tail;
+    out->max_depth = max_depth;
+    out->posted = posted;
+    out->stalls = stalls;
+    out->worst_stall_us = worst_stall_us;
+    out->flushes = flushes;
+    out->flush_bytes = flush_bytes;
+}
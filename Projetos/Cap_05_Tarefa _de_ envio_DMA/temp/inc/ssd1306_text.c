@@ -0,0 +1,150 @@
+#include "pico/stdlib.h"
+#include "ssd1306_core.h"
+#include "ssd1306_font_5x8.h"
+
+// Fonte 5x8 monoespaçada (avanço de 6 colunas)
+const ssd1306_font_t ssd1306_font_5x8 = {
+    .height = 8,
+    .width = 5,
+    .spacing = 1,
+    .index = font_5x8_index,
+    .glyphs = font_5x8_glyphs,
+};
+
+// Mesma fonte, com largura variável por glyph
+const ssd1306_font_t ssd1306_font_5x8_prop = {
+    .height = 8,
+    .width = 0,
+    .spacing = 1,
+    .index = font_5x8_index,
+    .glyphs = font_5x8_prop_glyphs,
+    .offsets = font_5x8_prop_offsets,
+    .widths = font_5x8_prop_widths,
+};
+
+// Decodifica o próximo caractere UTF-8 para Latin-1; o que estiver fora de Latin-1 vira 0x7F ('?' no índice)
+static inline uint8_t ssd1306_next_code(const char **text) {
+    const uint8_t *s = (const uint8_t *) *text;
+    uint8_t c = *s++;
+
+    if (c >= 0x80) {
+        if ((c == 0xC2 || c == 0xC3) && (*s & 0xC0) == 0x80) {
+            c = ((c & 0x03) << 6) | (*s++ & 0x3F);
+        }
+        else {
+            // Sequência fora de Latin-1 (ou inválida): pula os bytes de continuação
+            while ((*s & 0xC0) == 0x80) {
+                s++;
+            }
+            c = 0x7F;
+        }
+    }
+
+    *text = (const char *) s;
+    return c;
+}
+
+// Largura em colunas de um glyph, sem o espaçamento
+static inline int ssd1306_glyph_width(const ssd1306_font_t *font, uint8_t glyph) {
+    return font->width ? font->width : font->widths[glyph];
+}
+
+// Colunas de um glyph
+static inline const uint8_t *ssd1306_glyph_columns(const ssd1306_font_t *font, uint8_t glyph) {
+    return font->width ? font->glyphs + glyph * font->width : font->glyphs + font->offsets[glyph];
+}
+
+// Desenha um glyph (opaco: a célula inteira, incluindo o espaçamento, é sobrescrita) com o
+// canto superior esquerdo em (x, y). y não precisa ser múltiplo de 8: cada coluna é deslocada
+// e dividida entre as duas páginas que a célula cruza. Retorna o avanço em colunas
+ssd1306_core int ssd1306_draw_glyph_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, uint8_t code, const ssd1306_font_t *font) {
+    uint8_t glyph = font->index[code];
+    int width = ssd1306_glyph_width(font, glyph);
+    int advance = width + font->spacing;
+
+    if (y <= -font->height || y >= rows || x + advance <= 0 || x >= columns) {
+        return advance;
+    }
+
+    const uint8_t *glyph_columns = ssd1306_glyph_columns(font, glyph);
+    int page = y < 0 ? -1 : y / 8;
+    int shift = y - page * 8;
+    uint16_t mask = ((1u << font->height) - 1) << shift;
+    uint8_t *upper = page >= 0 ? ssd + page * columns : NULL;
+    uint8_t *lower = (mask >> 8) && page + 1 < rows / 8 ? ssd + (page + 1) * columns : NULL;
+    int changed_min = columns, changed_max = -1;
+
+    // Recorte horizontal feito uma vez, fora do laço
+    int first = x < 0 ? -x : 0;
+    int last = x + advance > columns ? columns - x : advance;
+
+    for (int i = first; i < last; i++) {
+        int column = x + i;
+        uint16_t bits = (i < width ? glyph_columns[i] : 0) << shift;
+        bool changed = false;
+
+        if (upper) {
+            uint8_t byte = (upper[column] & ~(uint8_t) mask) | (uint8_t) bits;
+            changed |= byte != upper[column];
+            upper[column] = byte;
+        }
+        if (lower) {
+            uint8_t byte = (lower[column] & ~(uint8_t) (mask >> 8)) | (uint8_t) (bits >> 8);
+            changed |= byte != lower[column];
+            lower[column] = byte;
+        }
+
+        if (changed) {
+            if (column < changed_min) changed_min = column;
+            changed_max = column;
+        }
+    }
+
+    if (changed_max >= 0) {
+        ssd1306_dirty_rect(dirty, columns, rows, changed_min, y, changed_max, y + font->height - 1);
+    }
+    return advance;
+}
+
+// Desenha um texto UTF-8 (ASCII + acentos Latin-1) a partir de (x, y); retorna o x após o último glyph
+ssd1306_core int ssd1306_draw_text_core(uint8_t *ssd, int columns, int rows, struct dirty_region *dirty, int x, int y, const char *text, const ssd1306_font_t *font) {
+    while (*text) {
+        x += ssd1306_draw_glyph_core(ssd, columns, rows, dirty, x, y, ssd1306_next_code(&text), font);
+    }
+    return x;
+}
+
+int ssd1306_draw_glyph(uint8_t *ssd, int x, int y, uint8_t code, const ssd1306_font_t *font) {
+    return ssd1306_legacy(ssd1306_draw_glyph_core, ssd, x, y, code, font);
+}
+
+int ssd1306_draw_text(uint8_t *ssd, int x, int y, const char *text, const ssd1306_font_t *font) {
+    return ssd1306_legacy(ssd1306_draw_text_core, ssd, x, y, text, font);
+}
+
+int ssd1306_display_draw_glyph(ssd1306_t *display, int x, int y, uint8_t code, const ssd1306_font_t *font) {
+    return ssd1306_dispatch(display, ssd1306_draw_glyph_core, x, y, code, font);
+}
+
+int ssd1306_display_draw_text(ssd1306_t *display, int x, int y, const char *text, const ssd1306_font_t *font) {
+    return ssd1306_dispatch(display, ssd1306_draw_text_core, x, y, text, font);
+}
+
+// Largura em colunas que o texto ocuparia, incluindo o espaçamento após o último glyph
+int ssd1306_text_width(const char *text, const ssd1306_font_t *font) {
+    int width = 0;
+    while (*text) {
+        width += ssd1306_glyph_width(font, font->index[ssd1306_next_code(&text)]) + font->spacing;
+    }
+    return width;
+}
+
+// Próximo caractere de um texto UTF-8, já convertido para o código Latin-1 usado pelas fontes
+uint8_t ssd1306_decode_char(const char **text) {
+    return ssd1306_next_code(text);
+}
+
+// Avanço em colunas de um caractere (largura do glyph + espaçamento)
+int ssd1306_glyph_advance(uint8_t code, const ssd1306_font_t *font) {
+    return ssd1306_glyph_width(font, font->index[code]) + font->spacing;
+}
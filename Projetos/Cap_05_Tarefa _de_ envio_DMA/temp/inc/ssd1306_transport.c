@@ -0,0 +1,177 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+
+// Camada de transporte do driver: toda transação i2c bloqueante passa por aqui. Cada tentativa
+// tem um prazo proporcional ao tamanho e à velocidade do barramento (i2c_write_timeout_us),
+// então um barramento preso não trava o firmware. Uma transação recusada (NACK) ou estourada
+// é repetida algumas vezes; se continuar falhando, o controlador desce para a velocidade
+// seguinte (1 MHz -> 400 kHz -> 100 kHz) e tenta de novo. Cada painel acumula os seus contadores
+
+// Velocidades em ordem decrescente
+static const uint bus_speeds[] = {
+    ssd1306_i2c_fast_mode_plus,
+    ssd1306_i2c_fast_mode,
+    ssd1306_i2c_standard_mode,
+};
+
+// Níveis vão de 0 a bus_speed_count - 1; com sinal, como os níveis (-1 = sem negociação)
+static const int bus_speed_count = count_of(bus_speeds);
+
+// Velocidade real de cada controlador (i2c0, i2c1); 0 = a configurada pela aplicação em
+// i2c_init, que o driver supõe ser ssd1306_i2c_clock
+static uint bus_speed[2] = { 0, 0 };
+
+// Nível de cada controlador: índice em bus_speeds da velocidade nominal pedida (-1 = a da
+// aplicação, sem negociação). As decisões comparam níveis, nunca a velocidade real, que
+// i2c_set_baudrate arredonda (pedindo 400 kHz a 125 MHz, o SDK devolve 399361 Hz)
+static int bus_level[2] = { -1, -1 };
+
+// Comando inofensivo usado para sondar o painel (NOP)
+static const uint8_t probe_script[] = { ssd1306_control_commands, 0xE3 };
+
+// Velocidade atual do controlador, em Hz
+uint ssd1306_transport_baudrate(i2c_inst_t *i2c) {
+    uint speed = bus_speed[i2c_hw_index(i2c)];
+    return speed ? speed : ssd1306_i2c_clock * 1000;
+}
+
+// Nível da maior velocidade nominal que não passa de 'baudrate'
+static int ssd1306_transport_level(uint baudrate) {
+    for (int i = 0; i < bus_speed_count; i++) {
+        if (bus_speeds[i] <= baudrate) {
+            return i;
+        }
+    }
+    return bus_speed_count - 1;
+}
+
+// Muda a velocidade do controlador (vale para todos os dispositivos ligados a ele). Retorna a
+// velocidade real
+uint ssd1306_transport_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    uint actual = i2c_set_baudrate(i2c, baudrate);
+    bus_speed[i2c_hw_index(i2c)] = actual;
+    bus_level[i2c_hw_index(i2c)] = ssd1306_transport_level(baudrate);
+    return actual;
+}
+
+// Prazo de uma transação de 'length' bytes: o dobro do tempo teórico (9 bits por byte, mais o
+// byte de endereço, START e STOP), para tolerar clock stretching, mais uma folga fixa
+static uint ssd1306_transport_timeout_us(i2c_inst_t *i2c, size_t length) {
+    uint64_t bits = (uint64_t) (length + 1) * 9 + 2;
+    return (uint) (2 * bits * 1000000 / ssd1306_transport_baudrate(i2c)) + ssd1306_i2c_timeout_margin_us;
+}
+
+// Desce o controlador para a velocidade seguinte; false se já estiver na mais lenta
+static bool ssd1306_transport_slow_down(i2c_inst_t *i2c) {
+    int level = bus_level[i2c_hw_index(i2c)];
+
+    if (level < 0) {
+        level = ssd1306_transport_level(ssd1306_i2c_clock * 1000);
+    }
+    if (level + 1 >= bus_speed_count) {
+        return false;
+    }
+    ssd1306_transport_set_baudrate(i2c, bus_speeds[level + 1]);
+    return true;
+}
+
+// Envia uma transação ao painel: 'control' (se não for negativo) seguido de 'buffer'.
+// Retorna false se ela foi abandonada (na velocidade mais lenta, depois de esgotadas as tentativas)
+static bool ssd1306_transport_send(ssd1306_t *display, int control, const uint8_t *buffer, size_t length) {
+    struct ssd1306_link_stats *link = &display->link;
+    uint32_t start = time_us_32();
+    int attempt = 0;
+    bool delivered = false;
+
+    if (control >= 0) {
+        length++;
+    }
+    while (true) {
+        uint timeout_us = ssd1306_transport_timeout_us(display->i2c_port, length);
+        int result = control >= 0
+            ? ssd1306_fifo_write_timeout_us(display->i2c_port, display->address, control, buffer, length - 1, timeout_us)
+            : i2c_write_timeout_us(display->i2c_port, display->address, buffer, length, false, timeout_us);
+        if (result == (int) length) {
+            delivered = true;
+            break;
+        }
+
+        if (result == PICO_ERROR_TIMEOUT) {
+            link->timeouts++;
+        }
+        else {
+            link->nacks++;
+        }
+
+        if (attempt < ssd1306_i2c_retries) {
+            attempt++;
+            link->retries++;
+        }
+        else if (ssd1306_transport_slow_down(display->i2c_port)) {
+            attempt = 0;
+        }
+        else {
+            link->failures++;
+            break;
+        }
+    }
+
+    if (delivered) {
+        link->transactions++;
+        link->bytes += length + 1; // +1 pelo byte de endereço
+    }
+    link->busy_us += time_us_32() - start;
+    return delivered;
+}
+
+// Envia uma transação já montada (byte de controle incluído em 'buffer')
+bool ssd1306_transport_write(ssd1306_t *display, const uint8_t *buffer, size_t length) {
+    return ssd1306_transport_send(display, -1, buffer, length);
+}
+
+// Envia 'length' bytes de 'data' precedidos do byte de controle 'control', sem copiar nem
+// alterar a memória do chamador
+bool ssd1306_transport_write_data(ssd1306_t *display, uint8_t control, const uint8_t *data, size_t length) {
+    return ssd1306_transport_send(display, control, data, length);
+}
+
+// Sonda o painel com 'count' comandos NOP seguidos, sem novas tentativas
+static bool ssd1306_transport_probe(ssd1306_t *display, int count) {
+    for (int i = 0; i < count; i++) {
+        int result = i2c_write_timeout_us(display->i2c_port, display->address, probe_script, sizeof(probe_script), false,
+                                          ssd1306_transport_timeout_us(display->i2c_port, sizeof(probe_script)));
+        if (result != sizeof(probe_script)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Escolhe a maior velocidade que o painel aceita: tenta Fast-mode Plus (1 MHz), depois 400 e
+// 100 kHz. Com vários painéis no mesmo controlador, negocie com cada um: a busca começa na
+// velocidade já negociada, então o controlador fica na do painel mais lento.
+// Retorna a velocidade real escolhida, ou 0 se o painel não respondeu em nenhuma
+uint ssd1306_transport_negotiate(ssd1306_t *display) {
+    int limit = bus_level[i2c_hw_index(display->i2c_port)];
+
+    for (int i = limit < 0 ? 0 : limit; i < bus_speed_count; i++) {
+        uint actual = ssd1306_transport_set_baudrate(display->i2c_port, bus_speeds[i]);
+        if (ssd1306_transport_probe(display, ssd1306_i2c_probe_count)) {
+            return actual;
+        }
+    }
+    return 0;
+}
+
+// Copia os contadores do enlace de um painel, com a velocidade atual do seu controlador
+void ssd1306_transport_get_stats(ssd1306_t *display, struct ssd1306_link_stats *out) {
+    *out = display->link;
+    out->baudrate = ssd1306_transport_baudrate(display->i2c_port);
+}
+
+// Zera os contadores do enlace de um painel
+void ssd1306_transport_reset_stats(ssd1306_t *display) {
+    memset(&display->link, 0, sizeof(display->link));
+}
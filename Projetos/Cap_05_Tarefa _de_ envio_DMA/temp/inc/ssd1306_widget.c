@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+// Widgets retidos sobre o framebuffer de um painel. Em vez de apagar e redesenhar a tela a cada
+// leitura, cada widget compara o valor novo com o que já está desenhado e refaz só o que mudou:
+// um campo "25.31" -> "25.38" redesenha um glyph e o flush envia só as colunas dele.
+// Para enviar apenas esses trechos, o painel precisa estar com o rastreamento de regiões sujas
+// ligado (ssd1306_display_set_dirty_tracking / ssd1306_set_dirty_tracking)
+
+static void ssd1306_widget_init(ssd1306_widget_t *widget, ssd1306_widget_type_t type, ssd1306_t *display, int x, int y) {
+    memset(widget, 0, sizeof(*widget));
+    widget->type = type;
+    widget->display = display;
+    widget->x = x;
+    widget->y = y;
+}
+
+// Rótulo de texto com o canto superior esquerdo em (x, y)
+void ssd1306_widget_init_label(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, const ssd1306_font_t *font) {
+    ssd1306_widget_init(widget, ssd1306_widget_label, display, x, y);
+    widget->text.font = font;
+}
+
+// Campo numérico de 'columns' caracteres, alinhado à direita, para valores em ponto fixo com
+// 'decimals' casas, de 0 a ssd1306_widget_max_decimals (ex.: 2531 com 2 casas aparece como
+// "25.31"); mais casas que isso são reduzidas ao máximo
+void ssd1306_widget_init_number(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, const ssd1306_font_t *font, int columns, int decimals) {
+    assert(columns <= ssd1306_widget_text_length && decimals >= 0 && decimals <= ssd1306_widget_max_decimals);
+    if (decimals < 0) decimals = 0;
+    if (decimals > ssd1306_widget_max_decimals) decimals = ssd1306_widget_max_decimals;
+
+    ssd1306_widget_init(widget, ssd1306_widget_number, display, x, y);
+    widget->text.font = font;
+    widget->text.columns = columns;
+    widget->text.decimals = decimals;
+}
+
+// Barra horizontal (width x height, com contorno) para valores de 'min' a 'max'
+void ssd1306_widget_init_bar(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y, int width, int height, int32_t min, int32_t max) {
+    assert(width > 4 && height > 4 && max > min);
+
+    ssd1306_widget_init(widget, ssd1306_widget_bar, display, x, y);
+    widget->bar.width = width;
+    widget->bar.height = height;
+    widget->bar.min = min;
+    widget->bar.max = max;
+}
+
+// Ícone (bitmap trocável) com o canto superior esquerdo em (x, y)
+void ssd1306_widget_init_icon(ssd1306_widget_t *widget, ssd1306_t *display, int x, int y) {
+    ssd1306_widget_init(widget, ssd1306_widget_icon, display, x, y);
+}
+
+// Força o redesenho completo na próxima atualização (ex.: depois de apagar a tela)
+void ssd1306_widget_invalidate(ssd1306_widget_t *widget) {
+    widget->valid = false;
+}
+
+// Atualiza o texto de um rótulo ou campo. Um glyph só é redesenhado se o código ou a posição
+// mudaram (numa fonte proporcional, tudo depois de uma largura diferente se desloca); se o
+// texto encurtou, só a sobra do texto anterior é apagada. Retorna true se algo foi desenhado
+bool ssd1306_widget_set_text(ssd1306_widget_t *widget, const char *text) {
+    const ssd1306_font_t *font = widget->text.font;
+    int x = widget->x, old_x = widget->x;
+    int count = 0;
+    bool changed = false;
+
+    while (*text && count < ssd1306_widget_text_length) {
+        uint8_t code = ssd1306_decode_char(&text);
+        int advance = ssd1306_glyph_advance(code, font);
+        bool kept = widget->valid && count < widget->text.length && widget->text.codes[count] == code && x == old_x;
+
+        if (widget->valid && count < widget->text.length) {
+            old_x += ssd1306_glyph_advance(widget->text.codes[count], font);
+        }
+        if (!kept) {
+            ssd1306_display_draw_glyph(widget->display, x, widget->y, code, font);
+            widget->text.codes[count] = code;
+            changed = true;
+        }
+
+        x += advance;
+        count++;
+    }
+
+    // Glyphs opacos cobrem as células novas; resta apagar o que sobrou do texto anterior
+    if (widget->valid && widget->text.end > x) {
+        ssd1306_display_clear_region(widget->display, x, widget->y, widget->text.end - x, font->height);
+        changed = true;
+    }
+
+    widget->text.length = count;
+    widget->text.end = x;
+    widget->valid = true;
+    return changed;
+}
+
+// Atualiza um campo numérico. Um valor que não cabe no campo aparece como "###"
+bool ssd1306_widget_set_number(ssd1306_widget_t *widget, int32_t value) {
+    char digits[1 + 10 + 1 + ssd1306_widget_max_decimals + 1]; // sinal, 10 dígitos, ponto, casas
+    char field[ssd1306_widget_text_length + 1];
+    uint32_t magnitude = value < 0 ? -(uint32_t) value : (uint32_t) value;
+    uint32_t scale = 1;
+
+    // Já limitado na criação; o limite repetido aqui deixa o tamanho de 'digits' à vista do compilador
+    int decimals = widget->text.decimals < ssd1306_widget_max_decimals ? widget->text.decimals : ssd1306_widget_max_decimals;
+    for (int i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+
+    if (decimals) {
+        snprintf(digits, sizeof(digits), "%s%lu.%0*lu", value < 0 ? "-" : "", (unsigned long) (magnitude / scale),
+                 decimals, (unsigned long) (magnitude % scale));
+    }
+    else {
+        snprintf(digits, sizeof(digits), "%s%lu", value < 0 ? "-" : "", (unsigned long) magnitude);
+    }
+
+    if ((int) strlen(digits) > widget->text.columns) {
+        memset(field, '#', widget->text.columns);
+        field[widget->text.columns] = '\0';
+    }
+    else {
+        snprintf(field, sizeof(field), "%*s", widget->text.columns, digits);
+    }
+
+    return ssd1306_widget_set_text(widget, field);
+}
+
+// Atualiza uma barra: só a faixa entre o preenchimento anterior e o novo é desenhada
+bool ssd1306_widget_set_bar(ssd1306_widget_t *widget, int32_t value) {
+    int inner_x = widget->x + 2, inner_y = widget->y + 2;
+    int inner_width = widget->bar.width - 4, inner_height = widget->bar.height - 4;
+
+    if (value < widget->bar.min) value = widget->bar.min;
+    if (value > widget->bar.max) value = widget->bar.max;
+    int filled = (int) ((int64_t) (value - widget->bar.min) * inner_width / (widget->bar.max - widget->bar.min));
+
+    if (!widget->valid) {
+        ssd1306_display_draw_rect(widget->display, widget->x, widget->y, widget->bar.width, widget->bar.height, ssd1306_mode_set);
+        ssd1306_display_clear_region(widget->display, widget->x + 1, widget->y + 1, widget->bar.width - 2, widget->bar.height - 2);
+        widget->bar.filled = 0;
+        widget->valid = true;
+    }
+    else if (filled == widget->bar.filled) {
+        return false;
+    }
+
+    if (filled > widget->bar.filled) {
+        ssd1306_display_fill_rect(widget->display, inner_x + widget->bar.filled, inner_y, filled - widget->bar.filled, inner_height, ssd1306_mode_set);
+    }
+    else if (filled < widget->bar.filled) {
+        ssd1306_display_fill_rect(widget->display, inner_x + filled, inner_y, widget->bar.filled - filled, inner_height, ssd1306_mode_clear);
+    }
+
+    widget->bar.filled = filled;
+    return true;
+}
+
+// Troca o ícone (NULL apaga). O blit só marca as colunas que mudaram; a área do ícone anterior
+// só é apagada quando o novo não a cobre
+bool ssd1306_widget_set_icon(ssd1306_widget_t *widget, const ssd1306_bitmap_t *bitmap) {
+    const ssd1306_bitmap_t *old = widget->valid ? widget->icon.bitmap : NULL;
+
+    if (widget->valid && bitmap == old) {
+        return false;
+    }
+
+    if (old && (!bitmap || bitmap->width < old->width || bitmap->height < old->height)) {
+        ssd1306_display_clear_region(widget->display, widget->x, widget->y, old->width, old->height);
+    }
+    if (bitmap) {
+        ssd1306_display_draw_image(widget->display, widget->x, widget->y, bitmap);
+    }
+
+    widget->icon.bitmap = bitmap;
+    widget->valid = true;
+    return true;
+}
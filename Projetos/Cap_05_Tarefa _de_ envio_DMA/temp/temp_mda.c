@@ -1,101 +1,553 @@
-
-
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-#include "hardware/adc.h"
-#include "hardware/dma.h"
-#include "hardware/i2c.h"
-#include "inc/ssd1306.h"
-
-#define NUM_SAMPLES 100
-const uint I2C_SDA = 14;
-const uint I2C_SCL = 15;
-
-uint16_t adc_buffer[NUM_SAMPLES];
-
-// Converte o valor bruto do ADC (12 bits) para temperatura em °C
-float convert_to_celsius(uint16_t raw) {
-    const float conversion_factor = 3.3f / (1 << 12);
-    float voltage = raw * conversion_factor;
-    return 27.0f - (voltage - 0.706f) / 0.001721f;
-}
-
-int main() {
-    stdio_init_all();
-    sleep_ms(2000);
-
-    // Inicializa I2C para OLED
-    i2c_init(i2c1, ssd1306_i2c_clock * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
-
-    // Inicializa OLED
-    ssd1306_init();
-
-    // Define área de renderização
-    struct render_area frame_area = {
-        .start_column = 0,
-        .end_column = ssd1306_width - 1,
-        .start_page = 0,
-        .end_page = ssd1306_n_pages - 1
-    };
-    calculate_render_area_buffer_length(&frame_area);
-
-    // Inicializa ADC e DMA
-    adc_init();
-    adc_set_temp_sensor_enabled(true);
-    adc_select_input(4); // Temperatura interna
-
-    int dma_chan = dma_claim_unused_channel(true);
-    dma_channel_config cfg = dma_channel_get_default_config(dma_chan);
-    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
-    channel_config_set_read_increment(&cfg, false);
-    channel_config_set_write_increment(&cfg, true);
-    channel_config_set_dreq(&cfg, DREQ_ADC);
-
-    while (true) {
-        adc_fifo_drain();
-        adc_run(false);
-        adc_fifo_setup(true, true, 1, false, false);
-        adc_run(true);
-
-        dma_channel_configure(
-            dma_chan,
-            &cfg,
-            adc_buffer,
-            &adc_hw->fifo,
-            NUM_SAMPLES,
-            true
-        );
-        dma_channel_wait_for_finish_blocking(dma_chan);
-        adc_run(false);
-
-        // Calcula média
-        float sum = 0.0f;
-        for (int i = 0; i < NUM_SAMPLES; i++) {
-            sum += convert_to_celsius(adc_buffer[i]);
-        }
-        float avg_temp = sum / NUM_SAMPLES;
-
-        // Mostra no terminal
-        printf("Temperatura média: %.2f °C\n", avg_temp);
-
-        // Prepara texto e exibe no OLED
-        char buffer[32];
-        snprintf(buffer, sizeof(buffer), "Temp: %.2f C", avg_temp);
-
-        uint8_t ssd[ssd1306_buffer_length];
-        memset(ssd, 0, ssd1306_buffer_length);
-        ssd1306_draw_string(ssd, 10, 20, buffer);
-        render_on_display(ssd, &frame_area);
-
-        sleep_ms(1000);
-    }
-
-    return 0;
-}
+
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "pico/binary_info.h"
+#include "hardware/adc.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+#include "inc/ssd1306.h"
+#include "inc/adc_capture.h"
+#include "inc/adc_temp.h"
+#include "inc/adc_cic.h"
+#include "inc/adc_filter.h"
+#include "inc/adc_stats.h"
+#include "inc/flash_log.h"
+#include "inc/adc_burst.h"
+#include "temp_assets.h" // gerado no build a partir de assets/ (tools/ssd1306_assets.cmake)
+
+// 1: o display é atendido pelo núcleo 1 (ssd1306_service) e o núcleo 0 nunca espera pelo i2c
+// 0: o próprio núcleo 0 desenha e dispara o envio por DMA
+#define DISPLAY_ON_CORE1 1
+
+// Acima desta temperatura (em centésimos de grau) o ícone de alerta substitui o termômetro
+#define ALERT_CENTI 4000
+
+// 1: na partida (modo DMA), mede a vazão máxima do envio por DMA e a taxa do modo de cinza
+#define GRAY_BENCHMARK 1
+
+// 1: na partida, compara em ciclos a conversão e a formatação em float com as inteiras
+#define TEMP_BENCHMARK 1
+
+// Entradas do ADC lidas em rodízio por um único fluxo de DMA: na BitDogLab, o joystick
+// (GPIO 26 e 27: entradas 0 e 1), o microfone (GPIO 28: entrada 2) e o sensor interno (4)
+#define ADC_INPUT_TEMPERATURE 4
+#define ADC_INPUT_MIC 2
+#define ADC_INPUTS ((1u << 0) | (1u << 1) | (1u << ADC_INPUT_MIC) | (1u << ADC_INPUT_TEMPERATURE))
+
+// Taxa total do ADC (dividida entre as entradas do rodízio), de 500 mil amostras/s para baixo
+#define ADC_SAMPLE_RATE 500000
+
+// Decimador CIC do microfone: ordem 3 e razão 2^4 = 16 (125 mil -> ~7,8 mil amostras/s, com
+// ~2 bits a mais de resolução efetiva)
+#define MIC_CIC_ORDER 3
+#define MIC_CIC_LOG2_RATIO 4
+
+// 1: na partida, mede em ciclos o custo do CIC por amostra e a carga da CPU a 500 mil amostras/s
+#define CIC_BENCHMARK 1
+
+// Registro das médias na flash: os últimos 64 setores (256 KiB; 340 registros por setor, ~6 h
+// com uma leitura por segundo)
+#define LOG_SECTORS 64
+#define LOG_OFFSET (PICO_FLASH_SIZE_BYTES - LOG_SECTORS * FLASH_SECTOR_SIZE)
+
+// 1: em vez da aquisição contínua, lê só o sensor de temperatura em rajadas de BURST_SAMPLES
+// amostras a cada BURST_PERIOD_US, com o ADC desligado e o núcleo 0 em __wfi entre elas
+#define LOW_POWER_BURSTS 0
+#define BURST_SAMPLES 1024
+#define BURST_PERIOD_US 1000000
+
+// Correntes para a estimativa do consumo médio no modo de rajadas, em uA: núcleo executando,
+// núcleo em __wfi (clocks ligados) e o ADC ligado. Valores de referência; troque pelos medidos na placa
+#define CURRENT_RUN_UA 24000
+#define CURRENT_WFI_UA 18000
+#define CURRENT_ADC_UA 600
+
+#if TEMP_BENCHMARK || CIC_BENCHMARK
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#endif
+
+const uint I2C_SDA = 14;
+const uint I2C_SCL = 15;
+
+// Soma dos códigos do sensor de temperatura desde a última leitura, acumulada na interrupção de
+// cada bloco
+static volatile uint64_t window_sum = 0;
+static volatile uint32_t window_count = 0;
+
+// Saída do CIC do microfone: faixa (em 1/16 de código) desde a última leitura
+static adc_cic_t mic_cic;
+static volatile uint16_t mic_low = 0xFFFF, mic_high = 0;
+static volatile uint32_t mic_outputs = 0;
+
+static void decimate_block(const uint16_t *samples, uint count) {
+    static uint16_t decimated[adc_capture_block_length];
+    uint16_t low = mic_low, high = mic_high;
+
+    uint n = adc_cic_process(&mic_cic, samples, count, decimated);
+    for (uint i = 0; i < n; i++) {
+        if (decimated[i] < low) low = decimated[i];
+        if (decimated[i] > high) high = decimated[i];
+    }
+    mic_low = low;
+    mic_high = high;
+    mic_outputs += n;
+}
+
+// Um registro por segundo: média em centésimos de grau e os códigos extremos da janela
+struct temp_record {
+    uint32_t uptime_s;
+    int32_t centi;
+    uint16_t min_code, max_code;
+};
+static flash_log_t temp_log;
+
+// Estatísticas das últimas 1024 amostras de cada entrada, atualizadas na interrupção de cada
+// bloco e lidas pelo laço principal sem parar a aquisição
+static adc_stats_t input_stats[adc_capture_inputs];
+
+// Histograma do sensor de temperatura: 16 faixas de 4 códigos a partir do 838 (~45 °C; o código
+// cresce quando a temperatura cai, então a última faixa fica perto de 15 °C)
+#define TEMP_HISTOGRAM_LOW 838
+#define TEMP_HISTOGRAM_SHIFT 2
+
+// Joystick (entradas 0 e 1) pela mediana de 5: um pico isolado de ruído não move a leitura
+static adc_filter_median_t joystick_filter[2];
+static volatile uint16_t joystick_filtered[2];
+
+static void filter_joystick(uint input, const uint16_t *samples, uint count) {
+    static uint16_t filtered[adc_capture_block_length];
+
+    adc_filter_median_process(&joystick_filter[input], samples, count, filtered);
+    joystick_filtered[input] = filtered[count - 1];
+}
+
+static void accumulate_block(uint input, const uint16_t *samples, uint count) {
+    adc_stats_push_block(&input_stats[input], samples, count);
+
+    if (input < 2) {
+        filter_joystick(input, samples, count);
+        return;
+    }
+    if (input == ADC_INPUT_MIC) {
+        decimate_block(samples, count);
+        return;
+    }
+    if (input != ADC_INPUT_TEMPERATURE) {
+        return;
+    }
+
+    uint32_t sum = 0;
+    for (uint i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    window_sum += sum;
+    window_count += count;
+}
+
+#if TEMP_BENCHMARK || CIC_BENCHMARK
+// Liga o SysTick em clk_sys, contando de 2^24 - 1 para baixo
+static void systick_start() {
+    systick_hw->rvr = 0xFFFFFF;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+// Ciclos de clk_sys desde 'start', pelo SysTick (contador decrescente de 24 bits: até ~134 ms a 125 MHz)
+static inline uint32_t cycles_since(uint32_t start) {
+    return (start - systick_hw->cvr) & 0xFFFFFF;
+}
+#endif
+
+#if TEMP_BENCHMARK
+// Conversão anterior, em float, mantida só como referência do benchmark
+static float convert_to_celsius(uint16_t raw) {
+    const float conversion_factor = 3.3f / (1 << 12);
+    float voltage = raw * conversion_factor;
+    return 27.0f - (voltage - 0.706f) / 0.001721f;
+}
+
+// Janela de 100 leituras, como o laço antigo: 100 conversões em float, média e "%.2f", contra
+// a soma dos códigos, uma conversão em Q16 e a formatação inteira
+static void benchmark_conversion() {
+    uint16_t samples[100];
+    char text[16];
+    volatile float float_sink;
+    volatile int32_t int_sink;
+
+    adc_select_input(ADC_INPUT_TEMPERATURE);
+    for (int i = 0; i < count_of(samples); i++) {
+        samples[i] = adc_read();
+    }
+
+    systick_start();
+
+    uint32_t start = systick_hw->cvr;
+    float sum = 0.0f;
+    for (int i = 0; i < count_of(samples); i++) {
+        sum += convert_to_celsius(samples[i]);
+    }
+    float average = sum / count_of(samples);
+    float_sink = average;
+    uint32_t float_convert = cycles_since(start);
+
+    start = systick_hw->cvr;
+    snprintf(text, sizeof(text), "%.2f", average);
+    uint32_t float_format = cycles_since(start);
+
+    start = systick_hw->cvr;
+    uint32_t code_sum = 0;
+    for (int i = 0; i < count_of(samples); i++) {
+        code_sum += samples[i];
+    }
+    int32_t centi = adc_temp_centi(code_sum, count_of(samples));
+    int_sink = centi;
+    uint32_t int_convert = cycles_since(start);
+
+    start = systick_hw->cvr;
+    adc_temp_format(text, sizeof(text), centi, 2);
+    uint32_t int_format = cycles_since(start);
+
+    (void) float_sink;
+    (void) int_sink;
+    printf("Conversão de 100 amostras: float %lu ciclos, inteiro %lu ciclos (%lux mais rápido)\n",
+           (unsigned long) float_convert, (unsigned long) int_convert, (unsigned long) (float_convert / int_convert));
+    printf("Formatação: %%.2f %lu ciclos, inteira %lu ciclos (%lux mais rápida), resultado %s °C\n",
+           (unsigned long) float_format, (unsigned long) int_format, (unsigned long) (float_format / int_format), text);
+}
+#endif
+
+#if CIC_BENCHMARK
+// Custo do CIC para uma entrada a 500 mil amostras/s, em cada ordem e razão válidas: ciclos por
+// amostra de entrada sobre um bloco do tamanho do DMA (o trabalho não depende dos valores) e a
+// fração de clk_sys que isso ocupa
+static void benchmark_cic() {
+    static uint16_t samples[adc_capture_block_length];
+    static uint16_t decimated[adc_capture_block_length];
+    uint32_t seed = 1;
+    uint32_t clock = clock_get_hz(clk_sys);
+
+    for (uint i = 0; i < adc_capture_block_length; i++) {
+        seed = seed * 1664525 + 1013904223;
+        samples[i] = seed >> 20;
+    }
+
+    systick_start();
+    for (int order = 1; order <= adc_cic_max_order; order++) {
+        for (int log2_ratio = 2; log2_ratio <= 8; log2_ratio += 2) {
+            if (12 + order * log2_ratio > 32) {
+                continue;
+            }
+            adc_cic_t cic;
+            adc_cic_init(&cic, order, log2_ratio);
+            adc_cic_process(&cic, samples, adc_capture_block_length, decimated); // código e dados no cache
+
+            uint32_t start = systick_hw->cvr;
+            adc_cic_process(&cic, samples, adc_capture_block_length, decimated);
+            uint32_t cycles = cycles_since(start);
+
+            // Centésimos de ciclo por amostra e centésimos de % da CPU a 500 mil amostras/s
+            uint32_t per_sample = (uint32_t) ((uint64_t) cycles * 100 / adc_capture_block_length);
+            uint32_t load = (uint32_t) ((uint64_t) cycles * 500000 * 10000 / adc_capture_block_length / clock);
+            printf("CIC N=%d R=%-3u -> %6lu amostras/s: %lu.%02lu ciclos/amostra, %lu.%02lu%% da CPU\n", order, 1u << log2_ratio,
+                   (unsigned long) (500000 >> log2_ratio), (unsigned long) (per_sample / 100), (unsigned long) (per_sample % 100),
+                   (unsigned long) (load / 100), (unsigned long) (load % 100));
+        }
+    }
+}
+#endif
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    // Inicializa I2C para OLED
+    i2c_init(i2c1, ssd1306_i2c_clock * 1000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+
+    // Usa a maior velocidade que o display aceitar (1 MHz, 400 kHz ou 100 kHz)
+    uint speed = ssd1306_transport_negotiate(&ssd1306_default_display);
+    printf("OLED i2c: %u kHz\n", speed / 1000);
+
+    // Inicializa OLED
+    ssd1306_init();
+
+    struct ssd1306_traffic boot;
+    ssd1306_get_traffic(ssd1306_op_init, &boot);
+    printf("OLED init: %lu transações, %lu bytes\n", (unsigned long) boot.transactions, (unsigned long) boot.bytes);
+
+    // Tendência da temperatura nas três últimas páginas: uma coluna por leitura (128 s de histórico)
+    static ssd1306_chart_t trend;
+    ssd1306_chart_init(&trend, &ssd1306_default_display, 0, 5, ssd1306_width, 3, 1);
+
+    // Tela montada uma vez; a cada leitura os widgets só redesenham os dígitos e o trecho da
+    // barra que mudaram, e o flush envia só essas colunas (a inicialização não desenha nada)
+    static ssd1306_widget_t caption, reading, unit, gauge;
+    ssd1306_widget_init_label(&caption, &ssd1306_default_display, 10, 20, &ssd1306_font_5x8);
+    ssd1306_widget_init_number(&reading, &ssd1306_default_display, 46, 20, &ssd1306_font_5x8, 6, 2);
+    ssd1306_widget_init_label(&unit, &ssd1306_default_display, 88, 20, &ssd1306_font_5x8);
+    ssd1306_widget_init_bar(&gauge, &ssd1306_default_display, 10, 30, 108, 8, 0, 5000); // 0 a 50 °C
+
+    // Ícone de estado no canto superior direito e faixa do gráfico no esquerdo, em dígitos 3x5
+    static ssd1306_widget_t status, range;
+    ssd1306_widget_init_icon(&status, &ssd1306_default_display, 110, 2);
+    ssd1306_widget_init_label(&range, &ssd1306_default_display, 2, 2, &asset_digitos_3x5);
+
+#if DISPLAY_ON_CORE1
+    // O núcleo 1 passa a ser o dono do framebuffer e do i2c (e do gráfico e dos widgets); o
+    // núcleo 0 só envia comandos
+    ssd1306_service_start(&ssd1306_default_display);
+    ssd1306_service_widget_set_text(&caption, "Temp:");
+    ssd1306_service_widget_set_text(&unit, " °C");
+#else
+    // Framebuffer persistente: só as colunas que mudarem entre leituras são retransmitidas
+    uint8_t *ssd = ssd1306_framebuffer.data;
+    memset(ssd, 0, ssd1306_buffer_length);
+    ssd1306_set_dirty_tracking(true);
+
+    // Envio do display por DMA, para que a amostragem não pare durante a transmissão
+    ssd1306_async_init(NULL);
+
+#if GRAY_BENCHMARK
+    // Rampa de quatro níveis na tela inteira: primeiro quadros sem pausa (vazão máxima do
+    // caminho DMA -> i2c), depois o rodízio pelo timer (taxa de atualização do cinza)
+    static ssd1306_gray_t gray;
+    struct ssd1306_gray_stats burst, paced;
+    ssd1306_gray_init(&gray, 0, 0, ssd1306_width, ssd1306_n_pages);
+    for (int level = 0; level < ssd1306_gray_levels; level++) {
+        ssd1306_gray_fill_rect(&gray, level * 32, 0, 32, 48, level);
+    }
+    ssd1306_gray_draw_text(&gray, 4, 52, "cinza: 4 níveis", &ssd1306_font_5x8, 3);
+
+    ssd1306_gray_benchmark(&gray, 500, &burst);
+    ssd1306_gray_start(&gray, 0);
+    sleep_ms(500);
+    ssd1306_gray_stop(&gray);
+    ssd1306_gray_get_stats(&gray, &paced);
+
+    printf("OLED DMA: %lu quadros/s, %lu kB/s (teórico: %lu us por quadro)\n",
+           (unsigned long) ((uint64_t) burst.frames * 1000000 / burst.elapsed_us),
+           (unsigned long) ((uint64_t) burst.bytes * 1000 / burst.elapsed_us), (unsigned long) burst.frame_us);
+    printf("OLED cinza: %lu quadros/s, %lu ciclos/s, %lu atrasos\n",
+           (unsigned long) ((uint64_t) paced.frames * 1000000 / paced.elapsed_us),
+           (unsigned long) ((uint64_t) paced.frames * 1000000 / paced.elapsed_us / ssd1306_gray_phases),
+           (unsigned long) paced.late);
+#endif
+
+    ssd1306_widget_set_text(&caption, "Temp:");
+    ssd1306_widget_set_text(&unit, " °C");
+#endif
+
+    // Abre o registro na flash (depois do serviço no núcleo 1, que precisa aceitar as pausas)
+    if (flash_log_init(&temp_log, LOG_OFFSET, LOG_SECTORS, sizeof(struct temp_record))) {
+        struct temp_record newest;
+        char celsius[16];
+        flash_log_read(&temp_log, 0, &newest);
+        adc_temp_format(celsius, sizeof(celsius), newest.centi, 2);
+        printf("Registro na flash: %lu médias; a mais recente, %s °C aos %lu s\n",
+               (unsigned long) flash_log_count(&temp_log), celsius, (unsigned long) newest.uptime_s);
+    }
+    else {
+        printf("Registro na flash: vazio\n");
+    }
+
+    // Inicializa o ADC e a aquisição contínua das entradas em rodízio: ADC_SAMPLE_RATE amostras/s
+    // divididas entre elas, sem pausas
+    adc_init();
+#if !LOW_POWER_BURSTS
+    adc_set_temp_sensor_enabled(true); // nas rajadas, o sensor é ligado só durante cada uma
+#endif
+    for (uint input = 0; input < 3; input++) {
+        if (ADC_INPUTS & (1u << input)) {
+            adc_gpio_init(26 + input);
+        }
+    }
+#if TEMP_BENCHMARK
+    benchmark_conversion();
+#endif
+#if CIC_BENCHMARK
+    benchmark_cic();
+#endif
+    uint32_t rate = adc_capture_set_rate(ADC_SAMPLE_RATE);
+    printf("ADC: %lu amostras/s no total\n", (unsigned long) rate);
+    adc_cic_init(&mic_cic, MIC_CIC_ORDER, MIC_CIC_LOG2_RATIO);
+    for (int axis = 0; axis < 2; axis++) {
+        adc_filter_median_init(&joystick_filter[axis], 5);
+    }
+    for (uint input = 0; input < adc_capture_inputs; input++) {
+        if (input == ADC_INPUT_TEMPERATURE) {
+            adc_stats_init(&input_stats[input], 10, TEMP_HISTOGRAM_LOW, TEMP_HISTOGRAM_SHIFT);
+        }
+        else {
+            adc_stats_init(&input_stats[input], 10, 0, 8); // 16 faixas de 256 códigos
+        }
+    }
+#if LOW_POWER_BURSTS
+    adc_burst_start(ADC_INPUT_TEMPERATURE, BURST_SAMPLES, BURST_PERIOD_US);
+    printf("ADC: rajadas de %u amostras a cada %lu us\n", BURST_SAMPLES, (unsigned long) BURST_PERIOD_US);
+#else
+    adc_capture_start_round_robin(ADC_INPUTS, accumulate_block);
+#endif
+
+    while (true) {
+#if LOW_POWER_BURSTS
+        // Dorme até a próxima rajada e a trata como um bloco da aquisição contínua
+        const uint16_t *samples;
+        struct adc_burst_record burst;
+        uint samples_count = adc_burst_wait(&samples, &burst);
+        accumulate_block(ADC_INPUT_TEMPERATURE, samples, samples_count);
+#else
+        sleep_ms(1000);
+#endif
+
+        // Média de todas as amostras do último segundo (a conversão é linear, então converter a
+        // média dos códigos dá o mesmo que a média das temperaturas)
+        uint32_t irq = save_and_disable_interrupts();
+        uint64_t sum = window_sum;
+        uint32_t count = window_count;
+#if !LOW_POWER_BURSTS
+        uint16_t mic_span = mic_outputs ? mic_high - mic_low : 0;
+        uint32_t mic_rate = mic_outputs;
+#endif
+        window_sum = 0;
+        window_count = 0;
+        mic_low = 0xFFFF;
+        mic_high = 0;
+        mic_outputs = 0;
+        restore_interrupts(irq);
+        if (count == 0) {
+            continue;
+        }
+
+        // Temperatura em centésimos de grau, só com inteiros (uma conversão por janela)
+        int32_t centi = adc_temp_centi(sum, count);
+        char celsius[16];
+        adc_temp_format(celsius, sizeof(celsius), centi, 2);
+
+        // Mostra no terminal
+        printf("Temperatura média: %s °C\n", celsius);
+
+        // Guarda no registro; quando um setor enche, ele é gravado e a gravação é relatada
+        struct adc_stats_summary temperature;
+        adc_stats_read(&input_stats[ADC_INPUT_TEMPERATURE], &temperature);
+        struct temp_record record = {
+            .uptime_s = (uint32_t) (time_us_64() / 1000000),
+            .centi = centi,
+            .min_code = temperature.min,
+            .max_code = temperature.max,
+        };
+        if (flash_log_append(&temp_log, &record) == flash_log_committed) {
+            struct flash_log_stats log;
+            flash_log_get_stats(&temp_log, &log);
+            uint32_t amplification = (uint32_t) (log.flash_bytes * 100 / log.payload_bytes);
+            printf("Flash: setor gravado em %lu us (apagar %lu, gravar %lu), pausa máx. %lu us, amplificação %lu.%02lu, %lu falhas\n",
+                   (unsigned long) log.last_commit_us, (unsigned long) log.erase_us, (unsigned long) log.program_us,
+                   (unsigned long) log.longest_lockout_us, (unsigned long) (amplification / 100),
+                   (unsigned long) (amplification % 100), (unsigned long) log.failures);
+        }
+
+#if DISPLAY_ON_CORE1
+        // Os mesmos widgets do modo DMA, atualizados pelo núcleo 1
+        ssd1306_service_widget_set_number(&reading, centi);
+        ssd1306_service_widget_set_bar(&gauge, centi);
+        ssd1306_service_widget_set_icon(&status, centi > ALERT_CENTI ? &asset_alerta : &asset_termometro);
+        ssd1306_service_chart_push(&trend, centi);
+        ssd1306_service_flush();
+
+        struct ssd1306_service_stats stats;
+        ssd1306_service_get_stats(&stats);
+        printf("OLED: fila %lu (máx. %lu), pior espera %lu us, %lu bytes enviados\n",
+               (unsigned long) stats.depth, (unsigned long) stats.max_depth,
+               (unsigned long) stats.worst_stall_us, (unsigned long) stats.flush_bytes);
+#else
+        ssd1306_widget_set_number(&reading, centi);
+        ssd1306_widget_set_bar(&gauge, centi);
+        ssd1306_widget_set_icon(&status, centi > ALERT_CENTI ? &asset_alerta : &asset_termometro);
+        if (ssd1306_chart_push(&trend, centi)) {
+            int32_t low, high;
+            char scale[24];
+            ssd1306_chart_get_range(&trend, &low, &high);
+            int length = adc_temp_format(scale, sizeof(scale), low, 1);
+            scale[length++] = '-';
+            adc_temp_format(scale + length, sizeof(scale) - length, high, 1);
+            ssd1306_widget_set_text(&range, scale);
+        }
+        int bytes = ssd1306_async_flush_dirty(ssd);
+        printf("OLED: %d bytes enviados\n", bytes);
+#endif
+
+        // Contadores do enlace (no modo núcleo 1, uma leitura aproximada de contadores do outro núcleo)
+        struct ssd1306_link_stats link;
+        ssd1306_transport_get_stats(&ssd1306_default_display, &link);
+        printf("I2C: %lu kHz, %lu transações, %lu NACK, %lu timeouts, %lu novas tentativas, %lu us no barramento\n",
+               (unsigned long) link.baudrate / 1000, (unsigned long) link.transactions, (unsigned long) link.nacks,
+               (unsigned long) link.timeouts, (unsigned long) link.retries, (unsigned long) link.busy_us);
+
+#if LOW_POWER_BURSTS
+        // Tempos da rajada e a fração do tempo total com o ADC ligado e com o núcleo acordado,
+        // de onde sai a estimativa da corrente média (e a economia sobre o ADC sempre ligado)
+        struct adc_burst_stats bursts;
+        adc_burst_get_stats(&bursts);
+        uint32_t adc_permille = (uint32_t) (bursts.adc_on_us * 1000 / bursts.elapsed_us);
+        uint32_t awake_permille = (uint32_t) (bursts.awake_us * 1000 / bursts.elapsed_us);
+        uint32_t average_ua = CURRENT_WFI_UA + ((CURRENT_RUN_UA - CURRENT_WFI_UA) * awake_permille + CURRENT_ADC_UA * adc_permille) / 1000;
+        uint32_t saving_ua = CURRENT_ADC_UA * (1000 - adc_permille) / 1000;
+        printf("Rajada %lu: ADC ligado %lu us, dormindo %lu us, acordado %lu us, %lu despertares\n",
+               (unsigned long) burst.sequence, (unsigned long) burst.adc_on_us, (unsigned long) burst.sleep_us,
+               (unsigned long) burst.awake_us, (unsigned long) burst.wakeups);
+        printf("  ADC ligado %lu.%lu%% do tempo, núcleo acordado %lu.%lu%%, ~%lu uA (%lu uA a menos que o ADC sempre ligado), %lu rajadas puladas, %lu perdidas\n",
+               (unsigned long) (adc_permille / 10), (unsigned long) (adc_permille % 10),
+               (unsigned long) (awake_permille / 10), (unsigned long) (awake_permille % 10),
+               (unsigned long) average_ua, (unsigned long) saving_ua, (unsigned long) bursts.missed, (unsigned long) bursts.overrun);
+#else
+        struct adc_capture_stats capture;
+        adc_capture_get_stats(&capture);
+        printf("ADC: %lu amostras/s, %lu amostras de temperatura na janela, %lu atrasos (%lu blocos perdidos), %lu%% da CPU na interrupção\n",
+               (unsigned long) (capture.samples * 1000000 / capture.elapsed_us), (unsigned long) count,
+               (unsigned long) capture.overruns, (unsigned long) capture.lost,
+               (unsigned long) (capture.irq_us * 100 / capture.elapsed_us));
+
+        // Cada entrada do rodízio: taxa própria, última leitura, estatísticas das últimas 1024
+        // amostras e, no microfone, a amplitude pico a pico da saída do CIC no último segundo
+        for (uint input = 0; input < adc_capture_inputs; input++) {
+            struct adc_capture_channel_stats channel;
+            if (!adc_capture_channel_stats(input, &channel)) {
+                continue;
+            }
+            struct adc_stats_summary window;
+            adc_stats_read(&input_stats[input], &window);
+
+            printf("  entrada %u: %lu amostras/s, última %u (há %lu us), janela %u-%u, média %lu.%02lu, desvio %lu.%02lu",
+                   input, (unsigned long) channel.rate, channel.latest, (unsigned long) (time_us_64() - channel.last_us),
+                   window.min, window.max, (unsigned long) (window.mean_q8 >> 8), (unsigned long) ((window.mean_q8 & 0xFF) * 100 >> 8),
+                   (unsigned long) (window.stddev_q8 >> 8), (unsigned long) ((window.stddev_q8 & 0xFF) * 100 >> 8));
+            if (input < 2) {
+                printf(", filtrada %u", joystick_filtered[input]);
+            }
+            if (input == ADC_INPUT_MIC) {
+                printf(", CIC: %lu amostras/s, pico a pico %u.%02u", (unsigned long) mic_rate, mic_span / 16, (mic_span % 16) * 100 / 16);
+            }
+            printf("\n");
+
+            if (input == ADC_INPUT_TEMPERATURE && window.count) {
+                // Extremos da janela em °C (o maior código é a menor temperatura) e o histograma
+                char coldest[16], hottest[16];
+                adc_temp_format(coldest, sizeof(coldest), adc_temp_centi_from_code(window.max), 2);
+                adc_temp_format(hottest, sizeof(hottest), adc_temp_centi_from_code(window.min), 2);
+                printf("    temperatura na janela: %s a %s °C, histograma", coldest, hottest);
+                for (int bin = 0; bin < adc_stats_bins; bin++) {
+                    printf(" %u", window.histogram[bin]);
+                }
+                printf("\n");
+            }
+        }
+#endif
+    }
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+# Conversão de assets do SSD1306 no build: imagens PBM/PNG e fontes BDF viram arrays constantes
+# (em flash) no formato de páginas do display, gerados por ssd1306_assets.py
+#
+#   include(tools/ssd1306_assets.cmake)
+#   ssd1306_add_assets(<alvo> GROUP <nome> [RLE] [RAW] [INVERT] ASSETS <arquivos>...)
+#
+# Gera <nome>.h e <nome>.c em ${CMAKE_CURRENT_BINARY_DIR}/assets e os acrescenta ao alvo; um
+# asset 'icone.png' vira 'asset_icone' (ssd1306_bitmap_t) e 'fonte.bdf' vira 'asset_fonte'
+# (ssd1306_font_t). Os arquivos são regerados quando um asset ou o conversor muda.
+#   RLE     compacta as imagens quando isso as deixa menores
+#   RAW     só bytes e dimensões, sem os tipos do driver (telas inteiras enviadas direto)
+#   INVERT  em PNG, pixels escuros são os acesos
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(SSD1306_ASSETS_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/ssd1306_assets.py)
+
+function(ssd1306_add_assets target)
+    cmake_parse_arguments(ARG "RLE;RAW;INVERT" "GROUP" "ASSETS" ${ARGN})
+    if(NOT ARG_GROUP OR NOT ARG_ASSETS)
+        message(FATAL_ERROR "ssd1306_add_assets(${target}): informe GROUP e ASSETS")
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/assets)
+    set(header ${out_dir}/${ARG_GROUP}.h)
+    set(source ${out_dir}/${ARG_GROUP}.c)
+
+    set(assets)
+    foreach(asset ${ARG_ASSETS})
+        get_filename_component(path ${asset} ABSOLUTE)
+        list(APPEND assets ${path})
+    endforeach()
+
+    set(options)
+    if(ARG_RLE)
+        list(APPEND options --rle)
+    endif()
+    if(ARG_RAW)
+        list(APPEND options --raw)
+    endif()
+    if(ARG_INVERT)
+        list(APPEND options --invert)
+    endif()
+
+    add_custom_command(
+        OUTPUT ${header} ${source}
+        COMMAND ${Python3_EXECUTABLE} ${SSD1306_ASSETS_SCRIPT} --group ${ARG_GROUP} --out-dir ${out_dir} ${options} ${assets}
+        DEPENDS ${SSD1306_ASSETS_SCRIPT} ${assets}
+        COMMENT "Convertendo assets do SSD1306 (${ARG_GROUP})"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE ${source} ${header})
+    target_include_directories(${target} PRIVATE ${out_dir})
+endfunction()
@@ -0,0 +1,430 @@
+#!/usr/bin/env python3
+# Conversor de assets para o driver SSD1306: imagens PBM/PNG e fontes BDF viram arrays
+# constantes (em flash) no formato de páginas do display, com um .h e um .c por grupo.
+#
+#   ssd1306_assets.py --group temp_assets --out-dir build/assets [--rle] [--raw] [--invert] arquivos...
+#
+# Imagens: cada página (8 linhas) vira 'width' bytes verticais, bit menos significativo em cima,
+# como ssd1306_bitmap_t. Em PBM, 1 é pixel aceso (as imagens de referência do emulador servem);
+# em PNG, pixels claros e opacos são acesos (--invert troca). Com --rle, a imagem é compactada
+# no formato de ssd1306_bitmap.c quando isso a deixa menor. Com --raw, só os bytes e as dimensões
+# são gerados, sem os tipos do driver (para telas inteiras enviadas direto ao display).
+# Fontes: glyphs Latin-1 (códigos 0-255) de até 8 linhas, como ssd1306_font_t; a fonte sai
+# monoespaçada se todos os avanços forem iguais, senão proporcional.
+# Usa só a biblioteca padrão do Python 3.
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+class AssetError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------------------------
+# Imagens -> matriz de pixels (lista de linhas de 0/1)
+
+def read_pbm(path):
+    with open(path, 'rb') as file:
+        data = file.read()
+
+    # Cabeçalho: número mágico, largura e altura, separados por espaços e comentários
+    tokens = []
+    position = 0
+    while len(tokens) < 3:
+        match = re.compile(rb'\s*(#[^\n]*\n\s*)*(\S+)').match(data, position)
+        if not match:
+            raise AssetError(f'{path}: cabeçalho PBM incompleto')
+        tokens.append(match.group(2))
+        position = match.end()
+
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    if magic == b'P1':
+        bits = [int(c) for c in re.sub(rb'#[^\n]*', b'', data[position:]).decode() if c in '01']
+        if len(bits) < width * height:
+            raise AssetError(f'{path}: dados PBM incompletos')
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+    if magic == b'P4':
+        position += 1  # um único espaço separa o cabeçalho dos dados
+        stride = (width + 7) // 8
+        if len(data) < position + stride * height:
+            raise AssetError(f'{path}: dados PBM incompletos')
+        rows = []
+        for y in range(height):
+            row = data[position + y * stride:position + (y + 1) * stride]
+            rows.append([(row[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+        return rows
+    raise AssetError(f'{path}: só PBM P1 e P4 são aceitos')
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path, invert):
+    with open(path, 'rb') as file:
+        data = file.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise AssetError(f'{path}: não é um PNG')
+
+    position = 8
+    idat = b''
+    palette = []
+    alphas = []
+    header = None
+    while position < len(data):
+        length, kind = struct.unpack('>I4s', data[position:position + 8])
+        body = data[position + 8:position + 8 + length]
+        position += 12 + length
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            alphas = list(body)
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    if header is None:
+        raise AssetError(f'{path}: PNG sem IHDR')
+    width, height, depth, color, _, _, interlace = header
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None or interlace:
+        raise AssetError(f'{path}: PNG entrelaçado ou com tipo de cor desconhecido')
+
+    # Desfaz os filtros de cada linha
+    raw = zlib.decompress(idat)
+    bits_per_pixel = channels * depth
+    stride = (width * bits_per_pixel + 7) // 8
+    step = max(1, bits_per_pixel // 8)
+    previous = bytearray(stride)
+    lines = []
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - step] if i >= step else 0
+            up = previous[i]
+            corner = previous[i - step] if i >= step else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                line[i] = (line[i] + paeth(left, up, corner)) & 0xFF
+        lines.append(line)
+        previous = line
+
+    # Amostras de cada pixel, normalizadas para 0-255
+    def samples(line, x):
+        if depth < 8:
+            per_byte = 8 // depth
+            byte = line[x // per_byte]
+            shift = 8 - depth * (x % per_byte + 1)
+            return [(byte >> shift) & ((1 << depth) - 1)]
+        size = depth // 8
+        base = x * channels * size
+        return [line[base + c * size] for c in range(channels)]
+
+    scale = 255 // ((1 << depth) - 1) if depth < 8 else 1
+    rows = []
+    for line in lines:
+        row = []
+        for x in range(width):
+            s = samples(line, x)
+            alpha = 255
+            if color == 3:
+                r, g, b = palette[s[0]]
+                alpha = alphas[s[0]] if s[0] < len(alphas) else 255
+            elif color in (0, 4):
+                r = g = b = s[0] * scale
+                if color == 4:
+                    alpha = s[1]
+            else:
+                r, g, b = s[0], s[1], s[2]
+                if color == 6:
+                    alpha = s[3]
+            luminance = (299 * r + 587 * g + 114 * b) // 1000
+            lit = luminance >= 128
+            if invert:
+                lit = not lit
+            row.append(1 if lit and alpha >= 128 else 0)
+        rows.append(row)
+    return rows
+
+
+# ---------------------------------------------------------------------------------------------
+# Formato de páginas e compactação
+
+def to_pages(rows):
+    height, width = len(rows), len(rows[0])
+    pages = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            pages.append(byte)
+    return bytes(pages)
+
+
+# Blocos de ssd1306_bitmap.c: 1nnnnnnn repete o byte seguinte n+1 vezes, 0nnnnnnn é seguido de
+# n+1 bytes literais. Repetições de 3 bytes ou mais viram blocos de repetição
+def rle_encode(data):
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 128:
+            run += 1
+        if run >= 3:
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+# ---------------------------------------------------------------------------------------------
+# Fontes BDF
+
+def read_bdf(path):
+    glyphs = {}
+    ascent = descent = None
+    default_char = None
+    with open(path, encoding='latin-1') as file:
+        lines = iter(file.read().splitlines())
+
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == 'FONT_ASCENT':
+            ascent = int(fields[1])
+        elif fields[0] == 'FONT_DESCENT':
+            descent = int(fields[1])
+        elif fields[0] == 'DEFAULT_CHAR':
+            default_char = int(fields[1])
+        elif fields[0] == 'STARTCHAR':
+            name = ' '.join(fields[1:])
+            encoding = advance = None
+            box = (0, 0, 0, 0)
+            for line in lines:
+                fields = line.split()
+                if not fields:
+                    continue
+                if fields[0] == 'ENCODING':
+                    encoding = int(fields[1])
+                elif fields[0] == 'DWIDTH':
+                    advance = int(fields[1])
+                elif fields[0] == 'BBX':
+                    box = tuple(int(v) for v in fields[1:5])
+                elif fields[0] == 'BITMAP':
+                    bitmap = []
+                    for line in lines:
+                        if line.strip() == 'ENDCHAR':
+                            break
+                        bitmap.append(int(line.strip(), 16))
+                    break
+            if encoding is None or advance is None:
+                raise AssetError(f'{path}: glyph {name} sem ENCODING ou DWIDTH')
+            if 0 <= encoding <= 255:
+                glyphs[encoding] = (name, advance, box, bitmap)
+
+    if ascent is None or descent is None:
+        raise AssetError(f'{path}: fonte sem FONT_ASCENT/FONT_DESCENT')
+    height = ascent + descent
+    if height > 8:
+        raise AssetError(f'{path}: {height} linhas; o driver aceita fontes de até 8')
+    if not glyphs:
+        raise AssetError(f'{path}: nenhum glyph Latin-1')
+
+    # Cada glyph vira 'advance' colunas verticais, com a linha de base em 'ascent'
+    columns = {}
+    for code, (name, advance, (w, h, x_offset, y_offset), bitmap) in glyphs.items():
+        row_bytes = (w + 7) // 8
+        glyph = [0] * advance
+        for r, value in enumerate(bitmap):
+            y = ascent - y_offset - h + r
+            for c in range(w):
+                x = x_offset + c
+                if value >> (row_bytes * 8 - 1 - c) & 1 and 0 <= x < advance and 0 <= y < height:
+                    glyph[x] |= 1 << y
+        columns[code] = (name, glyph)
+
+    if default_char not in columns:
+        default_char = ord('?') if ord('?') in columns else min(columns)
+    return height, columns, default_char
+
+
+# ---------------------------------------------------------------------------------------------
+# Geração de código
+
+def c_name(path):
+    stem = os.path.splitext(os.path.basename(path))[0]
+    name = re.sub(r'\W', '_', stem.lower())
+    return 'asset_' + name
+
+
+def byte_rows(data, per_line=16, indent='    '):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ', '.join(f'0x{b:02x}' for b in data[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def convert_image(path, rows, options, header, source):
+    name = c_name(path)
+    width, height = len(rows[0]), len(rows)
+    if width > 255 or height > 255:
+        raise AssetError(f'{path}: {width}x{height}; o driver aceita até 255x255')
+    pages = to_pages(rows)
+    base = os.path.basename(path)
+
+    if options.raw:
+        header.append(f'#define {name}_width {width}')
+        header.append(f'#define {name}_height {height}')
+        header.append(f'extern const uint8_t {name}[{len(pages)}]; // {base}: {width}x{height}, {len(pages)} bytes')
+        source.append(f'const uint8_t {name}[{len(pages)}] = {{\n{byte_rows(pages)}\n}};\n')
+        return
+
+    data, rle = pages, False
+    if options.rle:
+        packed = rle_encode(pages)
+        if len(packed) < len(pages):
+            data, rle = packed, True
+    size = f'{len(data)} bytes' + (f' compactados ({len(pages)} sem compactação)' if rle else '')
+    header.append(f'extern const ssd1306_bitmap_t {name}; // {base}: {width}x{height}, {size}')
+    source.append(f'static const uint8_t {name}_data[] = {{\n{byte_rows(data)}\n}};\n')
+    source.append(f'const ssd1306_bitmap_t {name} = {{ {width}, {height}, {"true" if rle else "false"}, {name}_data }};\n')
+
+
+def convert_font(path, options, header, source):
+    if options.raw:
+        raise AssetError(f'{path}: fontes precisam dos tipos do driver (sem --raw)')
+    name = c_name(path)
+    height, columns, default_char = read_bdf(path)
+    codes = sorted(columns)
+    if len(codes) > 256:
+        raise AssetError(f'{path}: mais de 256 glyphs')
+
+    number = {code: i for i, code in enumerate(codes)}
+    index = [number.get(code, number[default_char]) for code in range(256)]
+    widths = [len(columns[code][1]) for code in codes]
+    fixed = len(set(widths)) == 1
+
+    glyph_lines = []
+    offsets = []
+    offset = 0
+    for code in codes:
+        glyph_name, glyph = columns[code]
+        offsets.append(offset)
+        offset += len(glyph)
+        glyph_lines.append('    ' + ''.join(f'0x{b:02x}, ' for b in glyph) + f'// {glyph_name}')
+
+    base = os.path.basename(path)
+    kind = f'monoespaçada, {widths[0]} colunas' if fixed else 'proporcional'
+    header.append(f'extern const ssd1306_font_t {name}; // {base}: {len(codes)} glyphs, {height} linhas, {kind}')
+    source.append(f'static const uint8_t {name}_index[256] = {{\n' +
+                  '\n'.join('    ' + ', '.join(f'{v:3d}' for v in index[i:i + 16]) + ',' for i in range(0, 256, 16)) + '\n};\n')
+    source.append(f'static const uint8_t {name}_glyphs[] = {{\n' + '\n'.join(glyph_lines) + '\n};\n')
+    if fixed:
+        source.append(f'const ssd1306_font_t {name} = {{\n'
+                      f'    .height = {height},\n    .width = {widths[0]},\n    .spacing = 0,\n'
+                      f'    .index = {name}_index,\n    .glyphs = {name}_glyphs,\n}};\n')
+    else:
+        source.append(f'static const uint16_t {name}_offsets[] = {{\n' +
+                      '\n'.join('    ' + ', '.join(str(v) for v in offsets[i:i + 16]) + ',' for i in range(0, len(offsets), 16)) + '\n};\n')
+        source.append(f'static const uint8_t {name}_widths[] = {{\n' +
+                      '\n'.join('    ' + ', '.join(str(v) for v in widths[i:i + 16]) + ',' for i in range(0, len(widths), 16)) + '\n};\n')
+        source.append(f'const ssd1306_font_t {name} = {{\n'
+                      f'    .height = {height},\n    .width = 0,\n    .spacing = 0,\n'
+                      f'    .index = {name}_index,\n    .glyphs = {name}_glyphs,\n'
+                      f'    .offsets = {name}_offsets,\n    .widths = {name}_widths,\n}};\n')
+
+
+def write_if_changed(path, text):
+    # Mantém a data do arquivo quando nada mudou, para não recompilar à toa
+    if os.path.exists(path):
+        with open(path, encoding='utf-8') as file:
+            if file.read() == text:
+                return
+    with open(path, 'w', encoding='utf-8') as file:
+        file.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Converte imagens e fontes para o formato de páginas do SSD1306')
+    parser.add_argument('--group', required=True, help='nome do grupo (gera <grupo>.h e <grupo>.c)')
+    parser.add_argument('--out-dir', required=True)
+    parser.add_argument('--rle', action='store_true', help='compacta as imagens quando isso as deixa menores')
+    parser.add_argument('--raw', action='store_true', help='só bytes e dimensões, sem os tipos do driver')
+    parser.add_argument('--invert', action='store_true', help='em PNG, pixels escuros são os acesos')
+    parser.add_argument('assets', nargs='+')
+    options = parser.parse_args()
+
+    header, source = [], []
+    names = set()
+    try:
+        for path in options.assets:
+            name = c_name(path)
+            if name in names:
+                raise AssetError(f'{path}: nome {name} repetido no grupo')
+            names.add(name)
+
+            extension = os.path.splitext(path)[1].lower()
+            if extension == '.pbm':
+                convert_image(path, read_pbm(path), options, header, source)
+            elif extension == '.png':
+                convert_image(path, read_png(path, options.invert), options, header, source)
+            elif extension == '.bdf':
+                convert_font(path, options, header, source)
+            else:
+                raise AssetError(f'{path}: formato desconhecido (use .pbm, .png ou .bdf)')
+    except (AssetError, OSError, zlib.error) as error:
+        print(f'ssd1306_assets: {error}', file=sys.stderr)
+        return 1
+
+    group = options.group
+    sources = ', '.join(os.path.basename(p) for p in options.assets)
+    banner = f'// Gerado por ssd1306_assets.py a partir de {sources}. Não edite: altere os arquivos de origem\n'
+    types = '#include <stdint.h>\n' if options.raw else '#include "ssd1306_i2c.h"\n'
+
+    os.makedirs(options.out_dir, exist_ok=True)
+    write_if_changed(os.path.join(options.out_dir, group + '.h'),
+                     banner + f'#ifndef {group}_h\n#define {group}_h\n\n' + types + '\n' +
+                     '\n'.join(header) + f'\n\n#endif\n')
+    write_if_changed(os.path.join(options.out_dir, group + '.c'),
+                     banner + f'#include "{group}.h"\n\n' + '\n'.join(source))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())